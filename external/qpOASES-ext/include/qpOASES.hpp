@@ -38,14 +38,18 @@
 #include <SubjectTo.cpp>
 #include <Bounds.cpp>
 #include <Constraints.cpp>
+#include <LinearAlgebraKernels.cpp>
 #include <BLASReplacement.cpp>
 #include <LAPACKReplacement.cpp>
 #include <Matrices.cpp>
 #include <Options.cpp>
 #include <QProblemB.cpp>
+#include <Arena.cpp>
 #include <Flipper.cpp>
+#include <Workspace.cpp>
 #include <QProblem.cpp>
 #include <SQProblem.cpp>
+#include <SQProblemB.cpp>
 
 #ifndef __C_WRAPPER__
 #include <OQPinterface.cpp>
@@ -57,6 +61,7 @@
 #include <qpOASES/QProblemB.hpp>
 #include <qpOASES/QProblem.hpp>
 #include <qpOASES/SQProblem.hpp>
+#include <qpOASES/SQProblemB.hpp>
 #include <qpOASES/extras/OQPinterface.hpp>
 #include <qpOASES/extras/SolutionAnalysis.hpp>
 
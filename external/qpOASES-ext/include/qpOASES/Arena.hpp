@@ -0,0 +1,174 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/Arena.hpp
+ *
+ *	Declaration of the Arena class designed to place the persistent arrays
+ *	of several QProblemB and QProblem objects in a single memory block.
+ */
+
+
+#ifndef QPOASES_ARENA_HPP
+#define QPOASES_ARENA_HPP
+
+
+#include <qpOASES/Utils.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Alignment (in bytes) of the memory blocks obtained from an arena. */
+#define QPOASES_ARENA_ALIGNMENT 64
+
+
+/**
+ *	\brief Provides the persistent arrays of QP objects from a single memory block.
+ *
+ *	This class manages one memory block, allocated once by init(), from which
+ *	consecutive blocks are handed out (each one aligned to a cache line).
+ *	Blocks are never released individually: they are valid until the arena
+ *	is re-initialised or destroyed. If a request does not fit in the
+ *	remaining memory, getRealArray() falls back to the heap, and
+ *	freeRealArray() tells the two cases apart; so an arena which is too small
+ *	only costs the locality of the arrays which did not fit.
+ */
+class Arena
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		Arena( );
+
+		/** Constructor which takes the number of bytes to allocate. */
+		Arena(	unsigned int _size	/**< Number of bytes. */
+				);
+
+		/** Destructor. */
+		~Arena( );
+
+
+		/** Initialises object with given number of bytes to allocate.
+		 *	All blocks previously obtained from the arena become invalid.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue init(	unsigned int _size = 0	/**< Number of bytes. */
+							);
+
+		/** Returns a block of memory from the arena.
+		 *	\return Pointer to a block of (at least) n bytes, 0 if the arena is full */
+		void* getBlock(	unsigned int n	/**< Number of bytes. */
+						);
+
+		/** Returns an array from the arena or, if the arena is full, from the heap.
+		 *	\return Pointer to an array of (at least) n real_t values */
+		real_t* getRealArray(	int n	/**< Number of real_t values. */
+								);
+
+		/** Frees an array obtained by getRealArray(): arrays in the arena are
+		 *	left as they are, arrays on the heap are deleted. */
+		void freeRealArray(	real_t* array	/**< Array to be freed. */
+							);
+
+		/** Checks whether a pointer points into the arena.
+		 *	\return BT_TRUE  iff pointer lies in the arena \n
+		 			BT_FALSE otherwise */
+		inline BooleanType contains(	const void* const pointer	/**< Pointer to be checked. */
+										) const;
+
+		/** Returns the number of bytes of the arena.
+		 *	\return Number of bytes of the arena */
+		inline unsigned int getSize( ) const;
+
+		/** Returns the number of bytes handed out so far.
+		 *	\return Number of bytes handed out */
+		inline unsigned int getUsed( ) const;
+
+		/** Returns the number of bytes taken from an arena by a block of n bytes.
+		 *	\return Number of bytes rounded up to the alignment */
+		static inline unsigned int getBlockSize(	unsigned int n	/**< Number of bytes. */
+													);
+
+		/** Returns the number of bytes taken from an arena by an array of n real_t values.
+		 *	\return Number of bytes rounded up to the alignment */
+		static inline unsigned int getRealArraySize(	int n	/**< Number of real_t values. */
+														);
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory.
+		 *  \return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not available, blocks cannot be moved). */
+		Arena( const Arena& rhs );
+
+		/** Assignment operator (not available, blocks cannot be moved). */
+		Arena& operator=( const Arena& rhs );
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		char* memory;			/**< Memory as allocated. */
+		char* begin;			/**< First aligned byte of the memory. */
+		unsigned int size;		/**< Number of (aligned) bytes of the arena. */
+		unsigned int used;		/**< Number of bytes handed out so far. */
+};
+
+
+/** Returns an array from the given arena or, if arena is 0, from the heap.
+ *	\return Pointer to an array of (at least) n real_t values */
+inline real_t* allocateRealArray(	Arena* const arena,	/**< Arena (may be 0). */
+									int n				/**< Number of real_t values. */
+									);
+
+/** Frees an array obtained by allocateRealArray() with the same arena. */
+inline void freeRealArray(	Arena* const arena,	/**< Arena (may be 0). */
+							real_t* array		/**< Array to be freed. */
+							);
+
+
+END_NAMESPACE_QPOASES
+
+
+#include <qpOASES/Arena.ipp>
+
+#endif	/* QPOASES_ARENA_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,121 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/Arena.ipp
+ *
+ *	Implementation of inlined member functions of the Arena class.
+ */
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	c o n t a i n s
+ */
+inline BooleanType Arena::contains( const void* const pointer ) const
+{
+	if ( ( (const char*)pointer >= begin ) && ( (const char*)pointer < begin+size ) )
+		return BT_TRUE;
+	else
+		return BT_FALSE;
+}
+
+
+/*
+ *	g e t S i z e
+ */
+inline unsigned int Arena::getSize( ) const
+{
+	return size;
+}
+
+
+/*
+ *	g e t U s e d
+ */
+inline unsigned int Arena::getUsed( ) const
+{
+	return used;
+}
+
+
+/*
+ *	g e t B l o c k S i z e
+ */
+inline unsigned int Arena::getBlockSize( unsigned int n )
+{
+	/* empty blocks take some memory as well, so that they have their own address */
+	if ( n == 0 )
+		n = 1;
+
+	return ( ( n + QPOASES_ARENA_ALIGNMENT-1 ) / QPOASES_ARENA_ALIGNMENT ) * QPOASES_ARENA_ALIGNMENT;
+}
+
+
+/*
+ *	g e t R e a l A r r a y S i z e
+ */
+inline unsigned int Arena::getRealArraySize( int n )
+{
+	return getBlockSize( (unsigned int)getMax( n,0 ) * sizeof(real_t) );
+}
+
+
+/*
+ *	a l l o c a t e R e a l A r r a y
+ */
+inline real_t* allocateRealArray( Arena* const arena, int n )
+{
+	if ( arena != 0 )
+		return arena->getRealArray( n );
+	else
+		return new real_t[getMax( n,0 )];
+}
+
+
+/*
+ *	f r e e R e a l A r r a y
+ */
+inline void freeRealArray( Arena* const arena, real_t* array )
+{
+	if ( arena != 0 )
+		arena->freeRealArray( array );
+	else
+		delete[] array;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -39,6 +39,7 @@
 
 #include <qpOASES/Bounds.hpp>
 #include <qpOASES/Constraints.hpp>
+#include <qpOASES/Arena.hpp>
 
 
 BEGIN_NAMESPACE_QPOASES
@@ -50,6 +51,11 @@ BEGIN_NAMESPACE_QPOASES
  *	This auxiliary class stores a copy of the current matrix factorisations. It
  *	is used by the classe QProblemB and QProblem in case flipping bounds are enabled.
  *
+ *	Removing a bound or a constraint only appends a column to R and only rotates
+ *	the columns of Q spanning the range space (Y) together with the active block
+ *	of T. Hence only these parts are saved, which makes saving independent of the
+ *	size of the null space and free for problems without constraints.
+ *
  *	\author Hans Joachim Ferreau, Andreas Potschka, Christian Kirches
  *	\version 3.1
  *	\date 2007-2015
@@ -87,23 +93,24 @@ class Flipper
 		 *	\return SUCCESSFUL_RETURN \n
 		 			RET_INVALID_ARGUMENTS */
 		returnValue init(	unsigned int _nV = 0,	/**< Number of bounds. */
-							unsigned int _nC = 0		/**< Number of constraints. */
+							unsigned int _nC = 0,	/**< Number of constraints. */
+							Arena* _arena = 0		/**< Arena providing the matrices (0: heap). */
 							);
 
 
 		/** Copies current values to non-null arguments (assumed to be allocated with consistent size).
+		 *	Only the range space part of Q and the active block of T are written.
 		 *	\return SUCCESSFUL_RETURN */
 		returnValue get(	Bounds* const _bounds,					/**< Pointer to new bounds. */
-							real_t* const R,						/**< New matrix R. */
 							Constraints* const _constraints = 0,	/**< Pointer to new constraints. */
 							real_t* const _Q = 0,					/**< New matrix Q. */
 							real_t* const _T = 0					/**< New matrix T. */
 							) const;
 
-		/** Assigns new values to non-null arguments.
+		/** Assigns new values to non-null arguments. Only the range space part of Q
+		 *	and the active block of T are stored, which requires the constraints to be given.
 		 *	\return SUCCESSFUL_RETURN */
 		returnValue set(	const Bounds* const _bounds,				/**< Pointer to new bounds. */
-							const real_t* const _R,						/**< New matrix R. */
 							const Constraints* const _constraints = 0,	/**< Pointer to new constraints. */
 							const real_t* const _Q = 0,					/**< New matrix Q. */
 							const real_t* const _T = 0					/**< New matrix T. */
@@ -123,6 +130,10 @@ class Flipper
 		returnValue copy(	const Flipper& rhs	/**< Rhs object. */
 							);
 
+		/** Returns dimension of the stored columns of matrix Q.
+		 *  \return Dimension of the stored columns of matrix Q. */
+		unsigned int getDimQ( ) const;
+
 		/** Returns dimension of matrix T.
 		 *  \return Dimension of matrix T. */
 		unsigned int getDimT( ) const;
@@ -138,9 +149,10 @@ class Flipper
 		Bounds      bounds;				/**< Data structure for problem's bounds. */
 		Constraints constraints;		/**< Data structure for problem's constraints. */
 
-		real_t* R;						/**< Cholesky factor of H (i.e. H = R^T*R). */
-		real_t* Q;						/**< Orthonormal quadratic matrix, A = [0 T]*Q'. */
-		real_t* T;						/**< Reverse triangular matrix, A = [0 T]*Q'. */
+		real_t* Q;						/**< Range space columns Y of the orthonormal quadratic matrix, A = [0 T]*Q'. */
+		real_t* T;						/**< Active block of the reverse triangular matrix (stored densely), A = [0 T]*Q'. */
+
+		Arena* arena;					/**< Arena providing the matrices (or 0). */
 };
 
 
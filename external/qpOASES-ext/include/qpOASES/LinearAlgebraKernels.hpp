@@ -0,0 +1,107 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/LinearAlgebraKernels.hpp
+ *
+ *	Declaration of the kernels behind the BLAS/LAPACK replacement routines
+ *	dgemm_ and dpotrf_.
+ */
+
+
+#ifndef QPOASES_LINEARALGEBRAKERNELS_HPP
+#define QPOASES_LINEARALGEBRAKERNELS_HPP
+
+
+#include <qpOASES/Utils.hpp>
+
+
+/* The AVX2/FMA kernels rely on the target attribute and on the CPU detection
+ * builtins of GCC and clang; define __NO_AVX2_KERNELS__ to leave them out. */
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) ) && !defined(__NO_AVX2_KERNELS__)
+	#define QPOASES_AVX2_KERNELS
+
+	/** Compiles a function for CPUs supporting AVX2 and FMA. */
+	#define QPOASES_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Reference implementation of dgemm_ (plain loops). Computes
+ *	C = alpha*op(A)*B + beta*C with op(A) = A or A', depending on TRANSA;
+ *	TRANSB is ignored (B is never transposed by qpOASES). */
+void dgemmReference(	const char *TRANSA, const char *TRANSB,
+						const unsigned long *M, const unsigned long *N, const unsigned long *K,
+						const double *ALPHA, const double *A, const unsigned long *LDA, const double *B, const unsigned long *LDB,
+						const double *BETA, double *C, const unsigned long *LDC
+						);
+
+/** Reference implementation of dpotrf_ (plain loops). Computes the upper
+ *	Cholesky factor of a symmetric positive definite matrix in place; uplo
+ *	is ignored. If the matrix turns out not to be positive definite, the
+ *	failing diagonal element is tunneled to a[0]. */
+void dpotrfReference(	const char *uplo, const unsigned long *_n, double *a,
+						const unsigned long *_lda, long *info
+						);
+
+
+#ifdef QPOASES_AVX2_KERNELS
+
+/** Implementation of dgemm_ using AVX2 and FMA instructions: blocks of C are
+ *	kept in registers and the loads of A (or of B) are shared among them.
+ *	Must only be called if haveAVX2Kernels() returns BT_TRUE. */
+QPOASES_TARGET_AVX2 void dgemmAVX2(	const char *TRANSA, const char *TRANSB,
+									const unsigned long *M, const unsigned long *N, const unsigned long *K,
+									const double *ALPHA, const double *A, const unsigned long *LDA, const double *B, const unsigned long *LDB,
+									const double *BETA, double *C, const unsigned long *LDC
+									);
+
+/** Implementation of dpotrf_ using AVX2 and FMA instructions: each row of the
+ *	factor is computed four entries at a time.
+ *	Must only be called if haveAVX2Kernels() returns BT_TRUE. */
+QPOASES_TARGET_AVX2 void dpotrfAVX2(	const char *uplo, const unsigned long *_n, double *a,
+										const unsigned long *_lda, long *info
+										);
+
+#endif /* QPOASES_AVX2_KERNELS */
+
+
+/** Checks whether the AVX2/FMA kernels are compiled in and supported by the CPU.
+ *	\return BT_TRUE  iff the AVX2/FMA kernels can be used \n
+ *			BT_FALSE otherwise */
+BooleanType haveAVX2Kernels( );
+
+
+END_NAMESPACE_QPOASES
+
+
+#endif	/* QPOASES_LINEARALGEBRAKERNELS_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -325,6 +325,16 @@ class DenseMatrix : public virtual Matrix
 						real_t *v		/**< Values. */
 						) : nRows(m), nCols(n), leaDim(lD), val(v) {}
 
+		/** Re-initialises the matrix with a new vector of values; previously
+		 *  owned memory is freed and the new values are not owned.
+		 *  Caution: Data pointer must be valid throughout lifetime
+		 */
+		void init(	int m,			/**< Number of rows. */
+					int n,			/**< Number of columns. */
+					int lD,			/**< Leading dimension. */
+					real_t *v		/**< Values. */
+					);
+
 
 		/** Destructor. */
 		virtual ~DenseMatrix( );
@@ -467,17 +477,25 @@ class SymDenseMat : public DenseMatrix, public SymmetricMatrix
 {
 	public:
 		/** Default constructor. */
-		SymDenseMat() : DenseMatrix() { };
+		SymDenseMat() : DenseMatrix(), bilinearTmp(0), bilinearTmpSize(0) { };
 
 		/** Constructor from vector of values. */
 		SymDenseMat(	int m,			/**< Number of rows. */
 						int n,			/**< Number of columns. */
 						int lD,			/**< Leading dimension. */
 						real_t *v		/**< Values. */
-						) : DenseMatrix(m, n, lD, v) { };
+						) : DenseMatrix(m, n, lD, v), bilinearTmp(0), bilinearTmpSize(0) { };
+
+		/** Copy constructor (the temporary array of bilinear() is not copied). */
+		SymDenseMat(	const SymDenseMat& rhs	/**< Rhs object. */
+						) : Matrix(rhs), DenseMatrix(rhs), SymmetricMatrix(rhs), bilinearTmp(0), bilinearTmpSize(0) { };
 
 		/** Destructor. */
-		virtual ~SymDenseMat() { };
+		virtual ~SymDenseMat();
+
+		/** Assignment operator (the temporary array of bilinear() is not copied). */
+		SymDenseMat& operator=(	const SymDenseMat& rhs	/**< Rhs object. */
+								);
 
 		/** Returns a deep-copy of the Matrix object.
 		 *	\return Deep-copy of Matrix object */
@@ -497,6 +515,10 @@ class SymDenseMat : public DenseMatrix, public SymmetricMatrix
 										real_t *y,						/**< Output vector of results (compressed). */
 										int yLD							/**< Leading dimension of output y. */
 										) const;
+
+	protected:
+		mutable real_t *bilinearTmp;	/**< Temporary array of bilinear(), grown when needed. */
+		mutable int bilinearTmpSize;	/**< Size of the temporary array of bilinear(). */
 };
 
 
@@ -76,7 +76,8 @@ class QProblem : public QProblemB
 		 *  to the init() functions. */
 		QProblem(	int _nV,	  							/**< Number of variables. */
 					int _nC,		  						/**< Number of constraints. */
-					HessianType _hessianType = HST_UNKNOWN	/**< Type of Hessian matrix. */
+					HessianType _hessianType = HST_UNKNOWN,	/**< Type of Hessian matrix. */
+					Arena* _arena = 0						/**< Arena providing the persistent arrays (0: heap). */
 					);
 
 		/** Copy constructor (deep copy). */
@@ -90,6 +91,14 @@ class QProblem : public QProblemB
 		QProblem& operator=(	const QProblem& rhs	/**< Rhs object. */
 								);
 
+		/** Returns the number of bytes taken from an arena by the persistent
+		 *	arrays of a QProblem (or SQProblem) object of given dimensions.
+		 *	The object itself is not included.
+		 *	\return Number of bytes */
+		static unsigned int getArenaSize(	int _nV,	/**< Number of variables. */
+											int _nC		/**< Number of constraints. */
+											);
+
 
 		/** Clears all data structures of QProblemB except for QP data.
 		 *	\return SUCCESSFUL_RETURN \n
@@ -534,6 +543,13 @@ class QProblem : public QProblemB
 		 *			RET_INDEXLIST_CORRUPTED */
 		returnValue computeProjectedCholesky( );
 
+		/** Computes the projected Hessian Z^T*H*Z for a multiple of the identity
+		 *  H = diagVal*Id (i.e. HST_IDENTITY or regularised HST_ZERO) and stores it in R.
+		 *  R is expected to be all zeros.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue computeProjectedDiagHessian(	real_t diagVal	/**< Diagonal entry of the Hessian. */
+													);
+
 		/** Computes initial Cholesky decomposition of the projected Hessian making
 		 *  use of the function computeCholesky() or computeProjectedCholesky().
 		 *	\return SUCCESSFUL_RETURN \n
@@ -40,6 +40,7 @@
 
 
 #include <qpOASES/Flipper.hpp>
+#include <qpOASES/Workspace.hpp>
 #include <qpOASES/Options.hpp>
 #include <qpOASES/Matrices.hpp>
 
@@ -65,6 +66,9 @@ class QProblemB
 	/* allow SolutionAnalysis class to access private members */
 	friend class SolutionAnalysis;
 
+	/* allow SQProblemB class to set up a new auxiliary QP after a change of the Hessian */
+	friend class SQProblemB;
+
 	/*
 	 *	PUBLIC MEMBER FUNCTIONS
 	 */
@@ -78,7 +82,8 @@ class QProblemB
 		 *  is allocated for it and a NULL pointer can be passed for it
 		 *  to the init() functions. */
 		QProblemB(	int _nV,								/**< Number of variables. */
-					HessianType _hessianType = HST_UNKNOWN	/**< Type of Hessian matrix. */
+					HessianType _hessianType = HST_UNKNOWN,	/**< Type of Hessian matrix. */
+					Arena* _arena = 0						/**< Arena providing the persistent arrays (0: heap). */
 					);
 
 		/** Copy constructor (deep copy). */
@@ -92,6 +97,13 @@ class QProblemB
 		QProblemB& operator=(	const QProblemB& rhs	/**< Rhs object. */
 								);
 
+		/** Returns the number of bytes taken from an arena by the persistent
+		 *	arrays of a QProblemB object of given dimension.
+		 *	The object itself is not included.
+		 *	\return Number of bytes */
+		static unsigned int getArenaSize(	int _nV	/**< Number of variables. */
+											);
+
 
 		/** Clears all data structures of QProblemB except for QP data.
 		 *	\return SUCCESSFUL_RETURN \n
@@ -444,6 +456,29 @@ class QProblemB
 	 *	PROTECTED MEMBER FUNCTIONS
 	 */
 	protected:
+		/** Constructor used by derived classes, which also sizes the arrays
+		 *	depending on the number of constraints. */
+		QProblemB(	int _nV,						/**< Number of variables. */
+					int _nC,						/**< Number of constraints. */
+					HessianType _hessianType,		/**< Type of Hessian matrix. */
+					Arena* _arena					/**< Arena providing the persistent arrays (0: heap). */
+					);
+
+		/** Allocates and initialises all members (body of the constructors).
+		 *  \return SUCCESSFUL_RETURN */
+		returnValue construct(	int _nV,					/**< Number of variables. */
+								int _nC,					/**< Number of constraints. */
+								HessianType _hessianType,	/**< Type of Hessian matrix. */
+								Arena* _arena				/**< Arena providing the persistent arrays (0: heap). */
+								);
+
+		/** Returns the number of bytes taken from an arena by the persistent
+		 *	arrays of the QProblemB part of an object of given dimensions.
+		 *	\return Number of bytes */
+		static unsigned int getArenaSize(	int _nV,	/**< Number of variables. */
+											int _nC		/**< Number of constraints. */
+											);
+
 		/** Frees all allocated memory.
 		 *  \return SUCCESSFUL_RETURN */
 		returnValue clear( );
@@ -1004,6 +1039,10 @@ class QProblemB
 		
 		Flipper flipper;			/**< Struct for making a temporary copy of the matrix factorisations. */
 
+		Workspace workspace;		/**< Preallocated temporary arrays used on the hotstart path. */
+
+		Arena* arena;				/**< Arena providing the persistent arrays (or 0). */
+
 		TabularOutput tabularOutput;	/**< Struct storing information for tabular output (printLevel == PL_TABULAR). */
 };
 
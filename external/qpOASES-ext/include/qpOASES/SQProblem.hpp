@@ -75,7 +75,8 @@ class SQProblem : public QProblem
 		 *  to the init() functions. */
 		SQProblem(	int _nV,	  							/**< Number of variables. */
 					int _nC,  								/**< Number of constraints. */
-					HessianType _hessianType = HST_UNKNOWN	/**< Type of Hessian matrix. */
+					HessianType _hessianType = HST_UNKNOWN,	/**< Type of Hessian matrix. */
+					Arena* _arena = 0						/**< Arena providing the persistent arrays (0: heap). */
 					);
 
 		/** Copy constructor (deep copy). */
@@ -342,7 +343,8 @@ class SQProblem : public QProblem
 	 *	PROTECTED MEMBER VARIABLES
 	 */
 	protected:
-
+		Bounds oldBounds;				/**< Copy of the bounds made while setting up a new auxiliary QP. */
+		Constraints oldConstraints;		/**< Copy of the constraints made while setting up a new auxiliary QP. */
 };
 
 
@@ -0,0 +1,220 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/SQProblemB.hpp
+ *
+ *	Declaration of the SQProblemB class which is able to use the newly
+ *	developed online active set strategy for parametric quadratic programming
+ *	with varying Hessian matrix and bounds only.
+ */
+
+
+#ifndef QPOASES_SQPROBLEMB_HPP
+#define QPOASES_SQPROBLEMB_HPP
+
+
+#include <qpOASES/QProblemB.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Implements the online active set strategy for box-constrained QPs with varying Hessian matrix.
+ *
+ *	A class for setting up and solving sequences of quadratic programs with
+ *	(simple) bounds only, whose Hessian matrix may change from one QP to the next.
+ *	It is the counterpart of SQProblem without any constraint related work:
+ *	after a change of the Hessian matrix only the Cholesky factor of its free
+ *	part is computed afresh, no TQ factorisation is involved.
+ */
+class SQProblemB : public QProblemB
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		SQProblemB( );
+
+		/** Constructor which takes the QP dimension and Hessian type
+		 *  information. If the Hessian is the zero (i.e. HST_ZERO) or the
+		 *  identity matrix (i.e. HST_IDENTITY), respectively, no memory
+		 *  is allocated for it and a NULL pointer can be passed for it
+		 *  to the init() functions. */
+		SQProblemB(	int _nV,	  							/**< Number of variables. */
+					HessianType _hessianType = HST_UNKNOWN,	/**< Type of Hessian matrix. */
+					Arena* _arena = 0						/**< Arena providing the persistent arrays (0: heap). */
+					);
+
+		/** Copy constructor (deep copy). */
+		SQProblemB(	const SQProblemB& rhs	/**< Rhs object. */
+					);
+
+		/** Destructor. */
+		virtual ~SQProblemB( );
+
+		/** Assignment operator (deep copy). */
+		SQProblemB& operator=(	const SQProblemB& rhs	/**< Rhs object. */
+								);
+
+
+		/** Solves an initialised QP sequence with matrix shift using
+		 *	the online active set strategy.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_MAX_NWSR_REACHED \n
+		 			RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED \n
+					RET_HOTSTART_FAILED \n
+					RET_SHIFT_DETERMINATION_FAILED \n
+					RET_STEPDIRECTION_DETERMINATION_FAILED \n
+					RET_STEPLENGTH_DETERMINATION_FAILED \n
+					RET_HOMOTOPY_STEP_FAILED \n
+					RET_HOTSTART_STOPPED_INFEASIBILITY \n
+					RET_HOTSTART_STOPPED_UNBOUNDEDNESS \n
+					RET_SETUP_AUXILIARYQP_FAILED */
+		returnValue hotstart(	SymmetricMatrix *H_new,					/**< Hessian matrix of neighbouring QP to be solved (a shallow copy is made). \n
+																			 If Hessian matrix is trivial, a NULL pointer can be passed. */
+								const real_t* const g_new,				/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,				/**< Lower bounds of neighbouring QP to be solved. \n
+													 						 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,				/**< Upper bounds of neighbouring QP to be solved. \n
+													 						 If no upper bounds exist, a NULL pointer can be passed. */
+								int& nWSR,								/**< Input: Maximum number of working set recalculations; \n
+																			 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0,				/**< Input: Maximum CPU time allowed for QP solution. \n
+																			 Output: CPU time spent for QP solution (or to perform nWSR iterations). */
+								const Bounds* const guessedBounds = 0	/**< Optimal working set of bounds for solution (xOpt,yOpt). \n
+																			 (If a null pointer is passed, the previous working set is kept!) */
+								);
+
+		/** Solves an initialised QP sequence with matrix shift using
+		 *	the online active set strategy.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_MAX_NWSR_REACHED \n
+		 			RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED \n
+					RET_HOTSTART_FAILED \n
+					RET_SHIFT_DETERMINATION_FAILED \n
+					RET_STEPDIRECTION_DETERMINATION_FAILED \n
+					RET_STEPLENGTH_DETERMINATION_FAILED \n
+					RET_HOMOTOPY_STEP_FAILED \n
+					RET_HOTSTART_STOPPED_INFEASIBILITY \n
+					RET_HOTSTART_STOPPED_UNBOUNDEDNESS \n
+					RET_SETUP_AUXILIARYQP_FAILED */
+		returnValue hotstart(	const real_t* const H_new,				/**< Hessian matrix of neighbouring QP to be solved (a shallow copy is made). \n
+																			 If Hessian matrix is trivial, a NULL pointer can be passed. */
+								const real_t* const g_new,				/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,				/**< Lower bounds of neighbouring QP to be solved. \n
+													 						 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,				/**< Upper bounds of neighbouring QP to be solved. \n
+													 						 If no upper bounds exist, a NULL pointer can be passed. */
+								int& nWSR,								/**< Input: Maximum number of working set recalculations; \n
+																			 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0,				/**< Input: Maximum CPU time allowed for QP solution. \n
+																			 Output: CPU time spent for QP solution (or to perform nWSR iterations). */
+								const Bounds* const guessedBounds = 0	/**< Optimal working set of bounds for solution (xOpt,yOpt). \n
+																			 (If a null pointer is passed, the previous working set is kept!) */
+								);
+
+		/** Solves an initialised QP sequence (without matrix shift) using
+		 *	the online active set strategy.
+		 *
+		 *  Note: This functions just forwards to the corresponding
+		 *  	  QProblemB::hotstart member function.
+		 *
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_MAX_NWSR_REACHED \n
+		 			RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED \n
+					RET_HOTSTART_FAILED \n
+					RET_SHIFT_DETERMINATION_FAILED \n
+					RET_STEPDIRECTION_DETERMINATION_FAILED \n
+					RET_STEPLENGTH_DETERMINATION_FAILED \n
+					RET_HOMOTOPY_STEP_FAILED \n
+					RET_HOTSTART_STOPPED_INFEASIBILITY \n
+					RET_HOTSTART_STOPPED_UNBOUNDEDNESS */
+		returnValue hotstart(	const real_t* const g_new,				/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,				/**< Lower bounds of neighbouring QP to be solved. \n
+													 						 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,				/**< Upper bounds of neighbouring QP to be solved. \n
+													 						 If no upper bounds exist, a NULL pointer can be passed. */
+								int& nWSR,								/**< Input: Maximum number of working set recalculations; \n
+																			 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0,				/**< Input: Maximum CPU time allowed for QP solution. \n
+																			 Output: CPU time spent for QP solution (or to perform nWSR iterations). */
+								const Bounds* const guessedBounds = 0	/**< Optimal working set of bounds for solution (xOpt,yOpt). \n
+																			 (If a null pointer is passed, the previous working set is kept!) */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+
+		/** Sets a new Hessian matrix and calculates its Cholesky factorisation
+		 *  for the current working set. Afterwards, the gradient is transformed
+		 *  in order to start from an optimal solution.
+		 *	\return SUCCESSFUL_RETURN \n
+		 *			RET_SETUP_AUXILIARYQP_FAILED \n
+		 * 			RET_NO_HESSIAN_SPECIFIED */
+		virtual returnValue setupNewAuxiliaryQP(	SymmetricMatrix *H_new,		/**< New Hessian matrix. \n
+																					 If Hessian matrix is trivial, a NULL pointer can be passed. */
+													const real_t *lb_new,		/**< New lower bounds. \n
+														 						 	 If no lower bounds exist, a NULL pointer can be passed. */
+													const real_t *ub_new		/**< New upper bounds. \n
+														 						 	 If no upper bounds exist, a NULL pointer can be passed. */
+													);
+
+		/** Sets a new Hessian matrix and calculates its Cholesky factorisation
+		 *  for the current working set. Afterwards, the gradient is transformed
+		 *  in order to start from an optimal solution.
+		 *	\return SUCCESSFUL_RETURN \n
+		 *			RET_SETUP_AUXILIARYQP_FAILED \n
+		 * 			RET_NO_HESSIAN_SPECIFIED */
+		virtual returnValue setupNewAuxiliaryQP(	const real_t* const H_new,	/**< New dense Hessian matrix. \n
+																	     		 	 If Hessian matrix is trivial, a NULL pointer can be passed. */
+													const real_t *lb_new,		/**< New lower bounds. \n
+														 						 	 If no lower bounds exist, a NULL pointer can be passed. */
+													const real_t *ub_new		/**< New upper bounds. \n
+														 						 	 If no upper bounds exist, a NULL pointer can be passed. */
+													);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		Bounds oldBounds;				/**< Copy of the bounds made while setting up a new auxiliary QP. */
+};
+
+
+END_NAMESPACE_QPOASES
+
+
+#endif	/* QPOASES_SQPROBLEMB_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,192 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/Workspace.hpp
+ *
+ *	Declaration of the Workspace class designed to provide preallocated
+ *	temporary arrays to the QProblemB and QProblem classes.
+ */
+
+
+#ifndef QPOASES_WORKSPACE_HPP
+#define QPOASES_WORKSPACE_HPP
+
+
+#include <qpOASES/Arena.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Maximum number of memory blocks of a workspace. */
+#define QPOASES_WORKSPACE_MAXBLOCKS 32
+
+/** Number of real_t values preallocated for a QP with nV variables and nC
+ *	constraints; it covers the deepest nesting of temporary arrays on the
+ *	hotstart path (the workspace grows if it does not). */
+#define QPOASES_WORKSPACE_SIZE( nV,nC ) ( 16*( (nV)+(nC) ) + 8 )
+
+
+/**
+ *	\brief Provides preallocated temporary arrays.
+ *
+ *	This class manages a stack of real_t arrays which replaces the temporary
+ *	arrays allocated (and freed) on the hotstart path. The memory is allocated
+ *	once, by init(), possibly from an arena; if a request does not fit in it,
+ *	a new memory block is allocated and kept for the following requests.
+ *	Arrays are released in reverse order of their requests by means of a
+ *	WorkspaceScope object.
+ */
+class Workspace
+{
+	friend class WorkspaceScope;
+
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		Workspace( );
+
+		/** Constructor which takes the number of real_t values to preallocate. */
+		Workspace(	int _size	/**< Number of real_t values. */
+					);
+
+		/** Copy constructor (only the size is copied, not the contents). */
+		Workspace(	const Workspace& rhs	/**< Rhs object. */
+					);
+
+		/** Destructor. */
+		~Workspace( );
+
+		/** Assignment operator (only the size is copied, not the contents). */
+		Workspace& operator=(	const Workspace& rhs	/**< Rhs object. */
+								);
+
+
+		/** Initialises object with given number of real_t values to preallocate.
+		 *	All arrays previously obtained from the workspace become invalid.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue init(	int _size = 0,		/**< Number of real_t values. */
+							Arena* _arena = 0	/**< Arena providing the preallocated values (0: heap). */
+							);
+
+		/** Returns a temporary array, valid until the WorkspaceScope object
+		 *	which was created before the request is destroyed.
+		 *	\return Pointer to an array of (at least) n real_t values */
+		inline real_t* getRealArray(	int n	/**< Number of real_t values. */
+										);
+
+		/** Returns the number of preallocated real_t values.
+		 *	\return Number of preallocated real_t values */
+		inline int getSize( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory.
+		 *  \return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+		/** Moves to the next memory block, allocating it if it does not exist
+		 *	or if it is too small.
+		 *	\return Pointer to an array of (at least) n real_t values, 0 if
+		 			the maximum number of blocks is reached */
+		real_t* getNextBlock(	int n	/**< Number of real_t values. */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		real_t* block[QPOASES_WORKSPACE_MAXBLOCKS];		/**< Memory blocks. */
+		int blockSize[QPOASES_WORKSPACE_MAXBLOCKS];		/**< Number of real_t values of each memory block. */
+		int nBlocks;									/**< Number of allocated memory blocks. */
+
+		Arena* arena;									/**< Arena providing the first memory block (or 0). */
+
+		int currentBlock;								/**< Memory block in use. */
+		int top;										/**< Number of used real_t values of the memory block in use. */
+};
+
+
+/**
+ *	\brief Releases the arrays obtained from a workspace.
+ *
+ *	All arrays obtained from the workspace during the lifetime of a WorkspaceScope
+ *	object are released when it is destroyed; typically it is created at the
+ *	beginning of a function so that every return statement releases them.
+ */
+class WorkspaceScope
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Constructor which stores the current state of the workspace. */
+		inline WorkspaceScope(	Workspace& _workspace	/**< Workspace. */
+								);
+
+		/** Destructor, restores the state of the workspace. */
+		inline ~WorkspaceScope( );
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not available). */
+		WorkspaceScope( const WorkspaceScope& rhs );
+
+		/** Assignment operator (not available). */
+		WorkspaceScope& operator=( const WorkspaceScope& rhs );
+
+
+	/*
+	 *	PRIVATE MEMBER VARIABLES
+	 */
+	private:
+		Workspace& workspace;		/**< Workspace. */
+		int currentBlock;			/**< Memory block in use when the object was created. */
+		int top;					/**< Number of used real_t values when the object was created. */
+};
+
+
+END_NAMESPACE_QPOASES
+
+
+#include <qpOASES/Workspace.ipp>
+
+#endif	/* QPOASES_WORKSPACE_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,102 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/Workspace.ipp
+ *
+ *	Implementation of inlined member functions of the Workspace and
+ *	WorkspaceScope classes.
+ */
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	g e t R e a l A r r a y
+ */
+inline real_t* Workspace::getRealArray( int n )
+{
+	real_t* array;
+
+	if ( n < 0 )
+		n = 0;
+
+	if ( ( nBlocks > 0 ) && ( top + n <= blockSize[currentBlock] ) )
+	{
+		array = &(block[currentBlock][top]);
+		top += n;
+		return array;
+	}
+
+	return getNextBlock( n );
+}
+
+
+/*
+ *	g e t S i z e
+ */
+inline int Workspace::getSize( ) const
+{
+	int i, size = 0;
+
+	for( i=0; i<nBlocks; ++i )
+		size += blockSize[i];
+
+	return size;
+}
+
+
+/*
+ *	W o r k s p a c e S c o p e
+ */
+inline WorkspaceScope::WorkspaceScope( Workspace& _workspace ) :	workspace( _workspace ),
+																	currentBlock( _workspace.currentBlock ),
+																	top( _workspace.top )
+{
+}
+
+
+/*
+ *	~ W o r k s p a c e S c o p e
+ */
+inline WorkspaceScope::~WorkspaceScope( )
+{
+	workspace.currentBlock = currentBlock;
+	workspace.top = top;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,171 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/Arena.cpp
+ *
+ *	Implementation of the Arena class designed to place the persistent arrays
+ *	of several QProblemB and QProblem objects in a single memory block.
+ */
+
+
+#include <qpOASES/Arena.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	A r e n a
+ */
+Arena::Arena( )
+{
+	memory = 0;
+
+	init( );
+}
+
+
+/*
+ *	A r e n a
+ */
+Arena::Arena( unsigned int _size )
+{
+	memory = 0;
+
+	init( _size );
+}
+
+
+/*
+ *	~ A r e n a
+ */
+Arena::~Arena( )
+{
+	clear( );
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue Arena::init( unsigned int _size )
+{
+	clear( );
+
+	size = 0;
+	used = 0;
+
+	if ( _size > 0 )
+	{
+		size = getBlockSize( _size );
+		memory = new char[size + QPOASES_ARENA_ALIGNMENT-1];
+		begin = memory + ( QPOASES_ARENA_ALIGNMENT - (size_t)memory % QPOASES_ARENA_ALIGNMENT ) % QPOASES_ARENA_ALIGNMENT;
+	}
+	else
+		begin = 0;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t B l o c k
+ */
+void* Arena::getBlock( unsigned int n )
+{
+	void* block;
+
+	n = getBlockSize( n );
+
+	if ( used + n > size )
+		return 0;
+
+	block = begin + used;
+	used += n;
+
+	return block;
+}
+
+
+/*
+ *	g e t R e a l A r r a y
+ */
+real_t* Arena::getRealArray( int n )
+{
+	real_t* array;
+
+	if ( n < 0 )
+		n = 0;
+
+	array = (real_t*)getBlock( (unsigned int)n * sizeof(real_t) );
+
+	if ( array == 0 )
+		array = new real_t[n];
+
+	return array;
+}
+
+
+/*
+ *	f r e e R e a l A r r a y
+ */
+void Arena::freeRealArray( real_t* array )
+{
+	if ( contains( array ) == BT_FALSE )
+		delete[] array;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+/*
+ *	c l e a r
+ */
+returnValue Arena::clear( )
+{
+	if ( memory != 0 )
+	{
+		delete[] memory;
+		memory = 0;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -32,7 +32,7 @@
  */
 
 
-#include <qpOASES/Utils.hpp>
+#include <qpOASES/LinearAlgebraKernels.hpp>
 
 
 extern "C" void dgemm_ ( const char *TRANSA, const char *TRANSB,
@@ -40,53 +40,18 @@ extern "C" void dgemm_ ( const char *TRANSA, const char *TRANSB,
 		const double *ALPHA, const double *A, const unsigned long *LDA, const double *B, const unsigned long *LDB,
 		const double *BETA, double *C, const unsigned long *LDC)
 {
-	unsigned int i, j, k;
+	#ifdef QPOASES_AVX2_KERNELS
+	/* the kernel is selected once, depending on the CPU */
+	static const REFER_NAMESPACE_QPOASES BooleanType useAVX2 = REFER_NAMESPACE_QPOASES haveAVX2Kernels( );
 
-	if ( REFER_NAMESPACE_QPOASES isZero(*BETA) == REFER_NAMESPACE_QPOASES BT_TRUE )
-		for (k = 0; k < *N; k++)
-			for (j = 0; j < *M; j++)
-				C[j+(*LDC)*k] = 0.0;
-	else if ( REFER_NAMESPACE_QPOASES isEqual(*BETA,-1.0) == REFER_NAMESPACE_QPOASES BT_TRUE )
-		for (k = 0; k < *N; k++)
-			for (j = 0; j < *M; j++)
-				C[j+(*LDC)*k] = -C[j+(*LDC)*k];
-	else if ( REFER_NAMESPACE_QPOASES isEqual(*BETA,1.0) == REFER_NAMESPACE_QPOASES BT_FALSE )
-		for (k = 0; k < *N; k++)
-			for (j = 0; j < *M; j++)
-				C[j+(*LDC)*k] *= *BETA;
+	if ( useAVX2 == REFER_NAMESPACE_QPOASES BT_TRUE )
+	{
+		REFER_NAMESPACE_QPOASES dgemmAVX2( TRANSA,TRANSB, M,N,K, ALPHA,A,LDA, B,LDB, BETA,C,LDC );
+		return;
+	}
+	#endif /* QPOASES_AVX2_KERNELS */
 
-	if (TRANSA[0] == 'N')
-		if ( REFER_NAMESPACE_QPOASES isEqual(*ALPHA,1.0) == REFER_NAMESPACE_QPOASES BT_TRUE )
-			for (k = 0; k < *N; k++)
-				for (j = 0; j < *M; j++)
-					for (i = 0; i < *K; i++)
-						C[j+(*LDC)*k] += A[j+(*LDA)*i] * B[i+(*LDB)*k];
-		else if ( REFER_NAMESPACE_QPOASES isEqual(*ALPHA,-1.0) == REFER_NAMESPACE_QPOASES BT_TRUE )
-			for (k = 0; k < *N; k++)
-				for (j = 0; j < *M; j++)
-					for (i = 0; i < *K; i++)
-						C[j+(*LDC)*k] -= A[j+(*LDA)*i] * B[i+(*LDB)*k];
-		else
-			for (k = 0; k < *N; k++)
-				for (j = 0; j < *M; j++)
-					for (i = 0; i < *K; i++)
-						C[j+(*LDC)*k] += *ALPHA * A[j+(*LDA)*i] * B[i+(*LDB)*k];
-	else
-		if ( REFER_NAMESPACE_QPOASES isEqual(*ALPHA,1.0) == REFER_NAMESPACE_QPOASES BT_TRUE )
-			for (k = 0; k < *N; k++)
-				for (j = 0; j < *M; j++)
-					for (i = 0; i < *K; i++)
-						C[j+(*LDC)*k] += A[i+(*LDA)*j] * B[i+(*LDB)*k];
-		else if ( REFER_NAMESPACE_QPOASES isEqual(*ALPHA,-1.0) == REFER_NAMESPACE_QPOASES BT_TRUE )
-			for (k = 0; k < *N; k++)
-				for (j = 0; j < *M; j++)
-					for (i = 0; i < *K; i++)
-						C[j+(*LDC)*k] -= A[i+(*LDA)*j] * B[i+(*LDB)*k];
-		else
-			for (k = 0; k < *N; k++)
-				for (j = 0; j < *M; j++)
-					for (i = 0; i < *K; i++)
-						C[j+(*LDC)*k] += *ALPHA * A[i+(*LDA)*j] * B[i+(*LDB)*k];
+	REFER_NAMESPACE_QPOASES dgemmReference( TRANSA,TRANSB, M,N,K, ALPHA,A,LDA, B,LDB, BETA,C,LDC );
 }
 
 extern "C" void sgemm_ ( const char *TRANSA, const char *TRANSB,
@@ -49,9 +49,9 @@ BEGIN_NAMESPACE_QPOASES
  */
 Flipper::Flipper( )
 {
-	R = 0;
 	Q = 0;
 	T = 0;
+	arena = 0;
 	
 	init( );
 }
@@ -64,9 +64,9 @@ Flipper::Flipper(	unsigned int _nV,
 					unsigned int _nC
 					)
 {
-	R = 0;
 	Q = 0;
 	T = 0;
+	arena = 0;
 	
 	init( _nV,_nC );
 }
@@ -77,9 +77,9 @@ Flipper::Flipper(	unsigned int _nV,
  */
 Flipper::Flipper( const Flipper& rhs )
 {
-	R = 0;
 	Q = 0;
 	T = 0;
+	arena = 0;
 
 	copy( rhs );
 }
@@ -114,13 +114,25 @@ Flipper& Flipper::operator=( const Flipper& rhs )
  *	i n i t
  */
 returnValue Flipper::init(	unsigned int _nV,
-							unsigned int _nC
+							unsigned int _nC,
+							Arena* _arena
 							)
 {
 	clear( );
 
 	nV = _nV;
 	nC = _nC;
+	arena = _arena;
+
+	/* allocate all memory here as set() is called while hotstarting */
+	bounds.init( (int)nV );
+	constraints.init( (int)nC );
+
+	if ( getDimQ( ) > 0 )
+		Q = allocateRealArray( arena,getDimQ() );
+
+	if ( getDimT( ) > 0 )
+		T = allocateRealArray( arena,getDimT() );
 
 	return SUCCESSFUL_RETURN;
 }
@@ -131,26 +143,31 @@ returnValue Flipper::init(	unsigned int _nV,
  *	g e t
  */
 returnValue Flipper::get(	Bounds* const _bounds,
-							real_t* const _R,
 							Constraints* const _constraints,
 							real_t* const _Q,
 							real_t* const _T 
 							) const
 {
+	int i;
+	int nAC   = constraints.getNAC( );
+	int nZ    = bounds.getNFR( ) - nAC;
+	int sizeT = getMin( (int)nV,(int)nC );
+
 	if ( _bounds != 0 )
 		*_bounds = bounds;
 
 	if ( _constraints != 0 )
 		*_constraints = constraints;
 
-	if ( ( _R != 0 ) && ( R != 0 ) )
-		memcpy( _R,R, nV*nV*sizeof(real_t) );
+	if ( nAC == 0 )
+		return SUCCESSFUL_RETURN;
 
 	if ( ( _Q != 0 ) && ( Q != 0 ) )
-		memcpy( _Q,Q, nV*nV*sizeof(real_t) );
+		memcpy( &(_Q[nZ*nV]),Q, ((unsigned int)nAC)*nV*sizeof(real_t) );
 
 	if ( ( _T != 0 ) && ( T != 0 ) )
-		memcpy( _T,T, getDimT()*sizeof(real_t) );
+		for( i=0; i<nAC; ++i )
+			memcpy( &(_T[i*sizeT+sizeT-nAC]),&(T[i*nAC]), ((unsigned int)nAC)*sizeof(real_t) );
 
 	return SUCCESSFUL_RETURN;
 }
@@ -160,41 +177,34 @@ returnValue Flipper::get(	Bounds* const _bounds,
  *	s e t
  */
 returnValue Flipper::set(	const Bounds* const _bounds,
-							const real_t* const _R,
 							const Constraints* const _constraints,
 							const real_t* const _Q,
 							const real_t* const _T
 							)
 {
+	int i;
+
 	if ( _bounds != 0 )
 		bounds = *_bounds;
 
-	if ( _constraints != 0 )
-		constraints = *_constraints;
+	if ( _constraints == 0 )
+		return SUCCESSFUL_RETURN;
 
-	if ( _R != 0 )
-	{
-		if ( R == 0 )
-			R = new real_t[nV*nV];
+	constraints = *_constraints;
 
-		memcpy( R,_R, nV*nV*sizeof(real_t) );
-	}
+	int nAC   = constraints.getNAC( );
+	int nZ    = bounds.getNFR( ) - nAC;
+	int sizeT = getMin( (int)nV,(int)nC );
 
-	if ( _Q != 0 )
-	{
-		if ( Q == 0 )
-			Q = new real_t[nV*nV];
+	if ( nAC == 0 )
+		return SUCCESSFUL_RETURN;
 
-		memcpy( Q,_Q, nV*nV*sizeof(real_t) );
-	}
-
-	if ( _T != 0 )
-	{
-		if ( T == 0 )
-			T = new real_t[getDimT()];
+	if ( ( _Q != 0 ) && ( Q != 0 ) )
+		memcpy( Q,&(_Q[nZ*nV]), ((unsigned int)nAC)*nV*sizeof(real_t) );
 
-		memcpy( T,_T, getDimT()*sizeof(real_t) );
-	}
+	if ( ( _T != 0 ) && ( T != 0 ) )
+		for( i=0; i<nAC; ++i )
+			memcpy( &(T[i*nAC]),&(_T[i*sizeT+sizeT-nAC]), ((unsigned int)nAC)*sizeof(real_t) );
 
 	return SUCCESSFUL_RETURN;
 }
@@ -210,21 +220,15 @@ returnValue Flipper::set(	const Bounds* const _bounds,
  */
 returnValue Flipper::clear( )
 {
-	if ( R != 0 )
-	{
-		delete[] R;
-		R = 0;
-	}
-	
 	if ( Q != 0 )
 	{
-		delete[] Q;
+		freeRealArray( arena,Q );
 		Q = 0;
 	}
 	
 	if ( T != 0 )
 	{
-		delete[] T;
+		freeRealArray( arena,T );
 		T = 0;
 	}
 
@@ -238,10 +242,45 @@ returnValue Flipper::clear( )
 returnValue Flipper::copy(	const Flipper& rhs
 							)
 {
-	return set( &(rhs.bounds),rhs.R, &(rhs.constraints),rhs.Q,rhs.T );
+	/* copies keep their matrices on the heap */
+	nV = rhs.nV;
+	nC = rhs.nC;
+	arena = 0;
+
+	bounds = rhs.bounds;
+	constraints = rhs.constraints;
+
+	if ( rhs.Q != 0 )
+	{
+		Q = new real_t[getDimQ()];
+		memcpy( Q,rhs.Q, getDimQ()*sizeof(real_t) );
+	}
+
+	if ( rhs.T != 0 )
+	{
+		T = new real_t[getDimT()];
+		memcpy( T,rhs.T, getDimT()*sizeof(real_t) );
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t D i m Q
+ */
+unsigned int Flipper::getDimQ( ) const
+{
+	if ( nV > nC )
+		return nV*nC;
+	else
+		return nV*nV;
 }
 
 
+/*
+ *	g e t D i m T
+ */
 unsigned int Flipper::getDimT( ) const
 {
 	if ( nV > nC )
@@ -91,10 +91,24 @@ Indexlist::~Indexlist( )
  */
 Indexlist& Indexlist::operator=( const Indexlist& rhs )
 {
+	int i;
+
 	if ( this != &rhs )
 	{
-		clear( );
-		copy( rhs );
+		/* reuse the allocated memory if the physical length does not change */
+		if ( ( number != 0 ) && ( rhs.number != 0 ) && ( physicallength == rhs.physicallength ) )
+		{
+			length = rhs.length;
+			for( i=0; i<physicallength; ++i )
+				number[i] = rhs.number[i];
+			for( i=0; i<physicallength; ++i )
+				iSort[i] = rhs.iSort[i];
+		}
+		else
+		{
+			clear( );
+			copy( rhs );
+		}
 	}
 
 	return *this;
@@ -111,6 +125,13 @@ returnValue Indexlist::init(	int n
 	if ( n < 0 )
 		return THROWERROR( RET_INVALID_ARGUMENTS );
 
+	/* reuse the allocated memory if the physical length does not change */
+	if ( ( number != 0 ) && ( physicallength == n ) )
+	{
+		length = 0;
+		return SUCCESSFUL_RETURN;
+	}
+
 	clear( );
 
 	length = 0;
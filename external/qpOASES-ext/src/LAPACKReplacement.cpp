@@ -32,48 +32,25 @@
  */
 
 
-#include <qpOASES/Utils.hpp>
+#include <qpOASES/LinearAlgebraKernels.hpp>
 
 
 extern "C" void dpotrf_(	const char *uplo, const unsigned long *_n, double *a,
 							const unsigned long *_lda, long *info
 							)
 {
-	double sum;
-	long i, j, k;
-	long n = (long)(*_n);
-	long lda = (long)(*_lda);
+	#ifdef QPOASES_AVX2_KERNELS
+	/* the kernel is selected once, depending on the CPU */
+	static const REFER_NAMESPACE_QPOASES BooleanType useAVX2 = REFER_NAMESPACE_QPOASES haveAVX2Kernels( );
 
-	for( i=0; i<n; ++i )
+	if ( useAVX2 == REFER_NAMESPACE_QPOASES BT_TRUE )
 	{
-		/* j == i */
-		sum = a[i + lda*i];
-
-		for( k=(i-1); k>=0; --k )
-			sum -= a[k+lda*i] * a[k+lda*i];
-
-		if ( sum > 0.0 )
-			a[i+lda*i] = REFER_NAMESPACE_QPOASES getSqrt( sum );
-		else
-		{
-			a[0] = sum; /* tunnel negative diagonal element to caller */
-			if (info != 0)
-				*info = (long)i+1;
-			return;
-		}
-
-		for( j=(i+1); j<n; ++j )
-		{
-			sum = a[j*lda + i];
-
-			for( k=(i-1); k>=0; --k )
-				sum -= a[k+lda*i] * a[k+lda*j];
-
-			a[i+lda*j] = sum / a[i+lda*i];
-		}
+		REFER_NAMESPACE_QPOASES dpotrfAVX2( uplo,_n,a,_lda,info );
+		return;
 	}
-	if (info != 0)
-		*info = 0;
+	#endif /* QPOASES_AVX2_KERNELS */
+
+	REFER_NAMESPACE_QPOASES dpotrfReference( uplo,_n,a,_lda,info );
 }
 
 
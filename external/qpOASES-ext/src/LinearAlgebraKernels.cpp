@@ -0,0 +1,419 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/LinearAlgebraKernels.cpp
+ *
+ *	Implementation of the kernels behind the BLAS/LAPACK replacement routines
+ *	dgemm_ and dpotrf_.
+ */
+
+
+#include <qpOASES/LinearAlgebraKernels.hpp>
+
+#ifdef QPOASES_AVX2_KERNELS
+	#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	d g e m m R e f e r e n c e
+ */
+void dgemmReference(	const char *TRANSA, const char *TRANSB,
+						const unsigned long *M, const unsigned long *N, const unsigned long *K,
+						const double *ALPHA, const double *A, const unsigned long *LDA, const double *B, const unsigned long *LDB,
+						const double *BETA, double *C, const unsigned long *LDC
+						)
+{
+	unsigned int i, j, k;
+
+	if ( isZero(*BETA) == BT_TRUE )
+		for (k = 0; k < *N; k++)
+			for (j = 0; j < *M; j++)
+				C[j+(*LDC)*k] = 0.0;
+	else if ( isEqual(*BETA,-1.0) == BT_TRUE )
+		for (k = 0; k < *N; k++)
+			for (j = 0; j < *M; j++)
+				C[j+(*LDC)*k] = -C[j+(*LDC)*k];
+	else if ( isEqual(*BETA,1.0) == BT_FALSE )
+		for (k = 0; k < *N; k++)
+			for (j = 0; j < *M; j++)
+				C[j+(*LDC)*k] *= *BETA;
+
+	if (TRANSA[0] == 'N')
+		if ( isEqual(*ALPHA,1.0) == BT_TRUE )
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					for (i = 0; i < *K; i++)
+						C[j+(*LDC)*k] += A[j+(*LDA)*i] * B[i+(*LDB)*k];
+		else if ( isEqual(*ALPHA,-1.0) == BT_TRUE )
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					for (i = 0; i < *K; i++)
+						C[j+(*LDC)*k] -= A[j+(*LDA)*i] * B[i+(*LDB)*k];
+		else
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					for (i = 0; i < *K; i++)
+						C[j+(*LDC)*k] += *ALPHA * A[j+(*LDA)*i] * B[i+(*LDB)*k];
+	else
+		if ( isEqual(*ALPHA,1.0) == BT_TRUE )
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					for (i = 0; i < *K; i++)
+						C[j+(*LDC)*k] += A[i+(*LDA)*j] * B[i+(*LDB)*k];
+		else if ( isEqual(*ALPHA,-1.0) == BT_TRUE )
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					for (i = 0; i < *K; i++)
+						C[j+(*LDC)*k] -= A[i+(*LDA)*j] * B[i+(*LDB)*k];
+		else
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					for (i = 0; i < *K; i++)
+						C[j+(*LDC)*k] += *ALPHA * A[i+(*LDA)*j] * B[i+(*LDB)*k];
+}
+
+
+/*
+ *	d p o t r f R e f e r e n c e
+ */
+void dpotrfReference(	const char *uplo, const unsigned long *_n, double *a,
+						const unsigned long *_lda, long *info
+						)
+{
+	double sum;
+	long i, j, k;
+	long n = (long)(*_n);
+	long lda = (long)(*_lda);
+
+	for( i=0; i<n; ++i )
+	{
+		/* j == i */
+		sum = a[i + lda*i];
+
+		for( k=(i-1); k>=0; --k )
+			sum -= a[k+lda*i] * a[k+lda*i];
+
+		if ( sum > 0.0 )
+			a[i+lda*i] = getSqrt( sum );
+		else
+		{
+			a[0] = sum; /* tunnel negative diagonal element to caller */
+			if (info != 0)
+				*info = (long)i+1;
+			return;
+		}
+
+		for( j=(i+1); j<n; ++j )
+		{
+			sum = a[j*lda + i];
+
+			for( k=(i-1); k>=0; --k )
+				sum -= a[k+lda*i] * a[k+lda*j];
+
+			a[i+lda*j] = sum / a[i+lda*i];
+		}
+	}
+	if (info != 0)
+		*info = 0;
+}
+
+
+/*
+ *	h a v e A V X 2 K e r n e l s
+ */
+BooleanType haveAVX2Kernels( )
+{
+	#ifdef QPOASES_AVX2_KERNELS
+	__builtin_cpu_init( );
+
+	if ( ( __builtin_cpu_supports( "avx2" ) != 0 ) && ( __builtin_cpu_supports( "fma" ) != 0 ) )
+		return BT_TRUE;
+	#endif /* QPOASES_AVX2_KERNELS */
+
+	return BT_FALSE;
+}
+
+
+#ifdef QPOASES_AVX2_KERNELS
+
+/*
+ *	d o t 1
+ */
+/** Returns the dot product x'*a0 of two vectors of length n. */
+static inline QPOASES_TARGET_AVX2 double dot1(	const double *x, const double *a0, long n )
+{
+	long i;
+	double sum;
+	__m256d acc0 = _mm256_setzero_pd( );
+	__m256d acc1 = _mm256_setzero_pd( );
+	__m128d s;
+
+	for( i=0; i+8<=n; i+=8 )
+	{
+		acc0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a0[i]) ),_mm256_loadu_pd( &(x[i]) ),acc0 );
+		acc1 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a0[i+4]) ),_mm256_loadu_pd( &(x[i+4]) ),acc1 );
+	}
+	if ( i+4 <= n )
+	{
+		acc0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a0[i]) ),_mm256_loadu_pd( &(x[i]) ),acc0 );
+		i += 4;
+	}
+
+	acc0 = _mm256_add_pd( acc0,acc1 );
+	s = _mm_add_pd( _mm256_castpd256_pd128( acc0 ),_mm256_extractf128_pd( acc0,1 ) );
+	sum = _mm_cvtsd_f64( _mm_add_sd( s,_mm_unpackhi_pd( s,s ) ) );
+
+	for( ; i<n; ++i )
+		sum += a0[i] * x[i];
+
+	return sum;
+}
+
+
+/*
+ *	d o t 4
+ */
+/** Returns the dot products x'*a0, ..., x'*a3 of vectors of length n;
+ *	the loads of x are shared among the four products. */
+static inline QPOASES_TARGET_AVX2 __m256d dot4(	const double *x,
+												const double *a0, const double *a1, const double *a2, const double *a3,
+												long n
+												)
+{
+	long i;
+	__m256d xv, s01, s23, dots;
+	__m256d acc0 = _mm256_setzero_pd( );
+	__m256d acc1 = _mm256_setzero_pd( );
+	__m256d acc2 = _mm256_setzero_pd( );
+	__m256d acc3 = _mm256_setzero_pd( );
+
+	for( i=0; i+4<=n; i+=4 )
+	{
+		xv = _mm256_loadu_pd( &(x[i]) );
+		acc0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a0[i]) ),xv,acc0 );
+		acc1 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a1[i]) ),xv,acc1 );
+		acc2 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a2[i]) ),xv,acc2 );
+		acc3 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a3[i]) ),xv,acc3 );
+	}
+
+	/* horizontal sums: dots = [ sum(acc0), sum(acc1), sum(acc2), sum(acc3) ] */
+	s01  = _mm256_hadd_pd( acc0,acc1 );
+	s23  = _mm256_hadd_pd( acc2,acc3 );
+	dots = _mm256_add_pd( _mm256_blend_pd( s01,s23,0xC ),_mm256_permute2f128_pd( s01,s23,0x21 ) );
+
+	if ( i < n )
+	{
+		double t0 = 0.0, t1 = 0.0, t2 = 0.0, t3 = 0.0;
+
+		for( ; i<n; ++i )
+		{
+			t0 += a0[i] * x[i];
+			t1 += a1[i] * x[i];
+			t2 += a2[i] * x[i];
+			t3 += a3[i] * x[i];
+		}
+		dots = _mm256_add_pd( dots,_mm256_set_pd( t3,t2,t1,t0 ) );
+	}
+
+	return dots;
+}
+
+
+/*
+ *	d g e m m A V X 2
+ */
+QPOASES_TARGET_AVX2 void dgemmAVX2(	const char *TRANSA, const char *TRANSB,
+									const unsigned long *M, const unsigned long *N, const unsigned long *K,
+									const double *ALPHA, const double *A, const unsigned long *LDA, const double *B, const unsigned long *LDB,
+									const double *BETA, double *C, const unsigned long *LDC
+									)
+{
+	long i, j, k;
+	long m = (long)(*M);
+	long n = (long)(*N);
+	long nK = (long)(*K);
+	long lda = (long)(*LDA);
+	long ldb = (long)(*LDB);
+	long ldc = (long)(*LDC);
+	double alpha = *ALPHA;
+	double alphaB;
+	double *c;
+	const double *a, *b;
+	__m256d c0, c1, c2, c3, bv, av;
+
+	/* scale C as the reference implementation does */
+	if ( isZero(*BETA) == BT_TRUE )
+		for (k = 0; k < n; k++)
+			for (j = 0; j < m; j++)
+				C[j+ldc*k] = 0.0;
+	else if ( isEqual(*BETA,-1.0) == BT_TRUE )
+		for (k = 0; k < n; k++)
+			for (j = 0; j < m; j++)
+				C[j+ldc*k] = -C[j+ldc*k];
+	else if ( isEqual(*BETA,1.0) == BT_FALSE )
+		for (k = 0; k < n; k++)
+			for (j = 0; j < m; j++)
+				C[j+ldc*k] *= *BETA;
+
+	if ( TRANSA[0] == 'N' )
+	{
+		/* C(:,k) += A*(alpha*B(:,k)): blocks of 16 rows of C(:,k) are kept in
+		 * registers while the columns of A are streamed */
+		for( k=0; k<n; ++k )
+		{
+			c = &(C[ldc*k]);
+			b = &(B[ldb*k]);
+
+			for( j=0; j+16<=m; j+=16 )
+			{
+				c0 = _mm256_loadu_pd( &(c[j]) );
+				c1 = _mm256_loadu_pd( &(c[j+4]) );
+				c2 = _mm256_loadu_pd( &(c[j+8]) );
+				c3 = _mm256_loadu_pd( &(c[j+12]) );
+
+				for( i=0; i<nK; ++i )
+				{
+					a  = &(A[j+lda*i]);
+					bv = _mm256_set1_pd( alpha*b[i] );
+					c0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a[0]) ),bv,c0 );
+					c1 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a[4]) ),bv,c1 );
+					c2 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a[8]) ),bv,c2 );
+					c3 = _mm256_fmadd_pd( _mm256_loadu_pd( &(a[12]) ),bv,c3 );
+				}
+
+				_mm256_storeu_pd( &(c[j]),c0 );
+				_mm256_storeu_pd( &(c[j+4]),c1 );
+				_mm256_storeu_pd( &(c[j+8]),c2 );
+				_mm256_storeu_pd( &(c[j+12]),c3 );
+			}
+
+			for( ; j+4<=m; j+=4 )
+			{
+				c0 = _mm256_loadu_pd( &(c[j]) );
+				for( i=0; i<nK; ++i )
+					c0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(A[j+lda*i]) ),_mm256_set1_pd( alpha*b[i] ),c0 );
+				_mm256_storeu_pd( &(c[j]),c0 );
+			}
+
+			for( ; j<m; ++j )
+				for( i=0; i<nK; ++i )
+				{
+					alphaB = alpha*b[i];
+					c[j] += A[j+lda*i] * alphaB;
+				}
+		}
+	}
+	else
+	{
+		/* C(j,k) += alpha*A(:,j)'*B(:,k): four columns of A share the loads of B(:,k) */
+		av = _mm256_set1_pd( alpha );
+
+		for( k=0; k<n; ++k )
+		{
+			c = &(C[ldc*k]);
+			b = &(B[ldb*k]);
+
+			for( j=0; j+4<=m; j+=4 )
+			{
+				c0 = dot4( b, &(A[lda*j]),&(A[lda*(j+1)]),&(A[lda*(j+2)]),&(A[lda*(j+3)]), nK );
+				_mm256_storeu_pd( &(c[j]),_mm256_fmadd_pd( av,c0,_mm256_loadu_pd( &(c[j]) ) ) );
+			}
+
+			for( ; j<m; ++j )
+				c[j] += alpha * dot1( b,&(A[lda*j]),nK );
+		}
+	}
+}
+
+
+/*
+ *	d p o t r f A V X 2
+ */
+QPOASES_TARGET_AVX2 void dpotrfAVX2(	const char *uplo, const unsigned long *_n, double *a,
+										const unsigned long *_lda, long *info
+										)
+{
+	double sum, diag;
+	double dots[4];
+	long i, j, k;
+	long n = (long)(*_n);
+	long lda = (long)(*_lda);
+	const double *ai;
+
+	for( i=0; i<n; ++i )
+	{
+		/* column i of the factor computed so far (rows 0,...,i-1) */
+		ai = &(a[lda*i]);
+
+		/* j == i */
+		sum = a[i+lda*i] - dot1( ai,ai,i );
+
+		if ( sum > 0.0 )
+			a[i+lda*i] = getSqrt( sum );
+		else
+		{
+			a[0] = sum; /* tunnel negative diagonal element to caller */
+			if (info != 0)
+				*info = (long)i+1;
+			return;
+		}
+
+		/* j > i, four entries at a time */
+		diag = a[i+lda*i];
+
+		for( j=(i+1); j+4<=n; j+=4 )
+		{
+			_mm256_storeu_pd( dots,dot4( ai, &(a[lda*j]),&(a[lda*(j+1)]),&(a[lda*(j+2)]),&(a[lda*(j+3)]), i ) );
+
+			for( k=0; k<4; ++k )
+				a[i+lda*(j+k)] = ( a[i+lda*(j+k)] - dots[k] ) / diag;
+		}
+
+		for( ; j<n; ++j )
+			a[i+lda*j] = ( a[i+lda*j] - dot1( ai,&(a[lda*j]),i ) ) / diag;
+	}
+	if (info != 0)
+		*info = 0;
+}
+
+#endif /* QPOASES_AVX2_KERNELS */
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
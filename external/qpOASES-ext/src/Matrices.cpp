@@ -58,6 +58,18 @@ void DenseMatrix::free( )
 	val = 0;
 }
 
+void DenseMatrix::init( int m, int n, int lD, real_t *v )
+{
+	if ( needToFreeMemory( ) == BT_TRUE )
+		free( );
+	doNotFreeMemory( );
+
+	nRows = m;
+	nCols = n;
+	leaDim = lD;
+	val = v;
+}
+
 Matrix *DenseMatrix::duplicate( ) const
 {
 	DenseMatrix *dupl = 0;
@@ -453,6 +465,20 @@ returnValue DenseMatrix::print( const char* name ) const
 
 
 
+SymDenseMat::~SymDenseMat()
+{
+	if ( bilinearTmp != 0 )
+		delete[] bilinearTmp;
+}
+
+
+SymDenseMat& SymDenseMat::operator=( const SymDenseMat& rhs )
+{
+	DenseMatrix::operator=( rhs );
+	return *this;
+}
+
+
 Matrix *SymDenseMat::duplicate( ) const
 {
 	return duplicateSym();
@@ -490,7 +516,14 @@ returnValue SymDenseMat::bilinear(	const Indexlist* const icols,
 		for (jj = 0; jj < xN; jj++)
 			y[ii*yLD+jj] = 0.0;
 
-	real_t *Ax = new real_t[icols->length * xN];
+	if ( icols->length * xN > bilinearTmpSize )
+	{
+		if ( bilinearTmp != 0 )
+			delete[] bilinearTmp;
+		bilinearTmpSize = icols->length * xN;
+		bilinearTmp = new real_t[bilinearTmpSize];
+	}
+	real_t *Ax = bilinearTmp;
 
 	for (i=0;i<icols->length * xN;++i)
 		Ax[i]=0.0;
@@ -514,7 +547,6 @@ returnValue SymDenseMat::bilinear(	const Indexlist* const icols,
 			}
 		}
 	}
-	delete[] Ax;
 
 	return SUCCESSFUL_RETURN;
 }
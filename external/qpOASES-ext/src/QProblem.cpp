@@ -77,7 +77,7 @@ QProblem::QProblem( ) : QProblemB( )
 /*
  *	Q P r o b l e m
  */
-QProblem::QProblem( int _nV, int _nC, HessianType _hessianType ) : QProblemB( _nV,_hessianType )
+QProblem::QProblem( int _nV, int _nC, HessianType _hessianType, Arena* _arena ) : QProblemB( _nV,_nC,_hessianType,_arena )
 {
 	int i;
 
@@ -99,10 +99,10 @@ QProblem::QProblem( int _nV, int _nC, HessianType _hessianType ) : QProblemB( _n
 		freeConstraintMatrix = BT_FALSE;
 		A = 0;
 
-		lbA = new real_t[_nC];
+		lbA = allocateRealArray( arena,_nC );
 		for( i=0; i<_nC; ++i ) lbA[i] = 0.0;
 
-		ubA = new real_t[_nC];
+		ubA = allocateRealArray( arena,_nC );
 		for( i=0; i<_nC; ++i ) ubA[i] = 0.0;
 	}
 	else
@@ -118,19 +118,17 @@ QProblem::QProblem( int _nV, int _nC, HessianType _hessianType ) : QProblemB( _n
 
 	constraints.init( _nC );
 
-	delete[] y; /* y of no constraints version too short! */
-	y = new real_t[_nV+_nC];
-	for( i=0; i<_nV+_nC; ++i ) y[i] = 0.0;
+	/* y, the flipper and the workspace have been sized by QProblemB */
 
 	sizeT = getMin( _nV,_nC );
-	T = new real_t[sizeT*sizeT];
-	Q = new real_t[_nV*_nV];
+	T = allocateRealArray( arena,sizeT*sizeT );
+	Q = allocateRealArray( arena,_nV*_nV );
 
 	if ( _nC > 0 )
 	{
-		Ax = new real_t[_nC];
-		Ax_l = new real_t[_nC];
-		Ax_u = new real_t[_nC];
+		Ax = allocateRealArray( arena,_nC );
+		Ax_l = allocateRealArray( arena,_nC );
+		Ax_u = allocateRealArray( arena,_nC );
 	}
 	else
 	{
@@ -141,15 +139,15 @@ QProblem::QProblem( int _nV, int _nC, HessianType _hessianType ) : QProblemB( _n
 
 	constraintProduct = 0;
 
-	tempA = new real_t[_nV];			/* nFR */
-	ZFR_delta_xFRz = new real_t[_nV];	/* nFR */
-	delta_xFRz = new real_t[_nV];		/* nZ */
+	tempA = allocateRealArray( arena,_nV );			/* nFR */
+	ZFR_delta_xFRz = allocateRealArray( arena,_nV );	/* nFR */
+	delta_xFRz = allocateRealArray( arena,_nV );		/* nZ */
 
 	if ( _nC > 0 )
 	{
-		tempB = new real_t[_nC];			/* nAC */
-		delta_xFRy = new real_t[_nC];		/* nAC */
-		delta_yAC_TMP = new real_t[_nC];   /* nAC */
+		tempB = allocateRealArray( arena,_nC );			/* nAC */
+		delta_xFRy = allocateRealArray( arena,_nC );		/* nAC */
+		delta_yAC_TMP = allocateRealArray( arena,_nC );	/* nAC */
 	}
 	else
 	{
@@ -157,8 +155,6 @@ QProblem::QProblem( int _nV, int _nC, HessianType _hessianType ) : QProblemB( _n
 		delta_xFRy = 0;
 		delta_yAC_TMP = 0;
 	}
-
-	flipper.init( (unsigned int)_nV,(unsigned int)_nC );
 }
 
 
@@ -199,6 +195,26 @@ QProblem& QProblem::operator=( const QProblem& rhs )
 }
 
 
+/*
+ *	g e t A r e n a S i z e
+ */
+unsigned int QProblem::getArenaSize( int _nV, int _nC )
+{
+	unsigned int size = QProblemB::getArenaSize( _nV,_nC );
+
+	/* T, Q, tempA, ZFR_delta_xFRz and delta_xFRz */
+	size += Arena::getRealArraySize( getMin( _nV,_nC ) * getMin( _nV,_nC ) );
+	size += Arena::getRealArraySize( _nV*_nV );
+	size += 3 * Arena::getRealArraySize( _nV );
+
+	/* lbA, ubA, Ax, Ax_l, Ax_u, tempB, delta_xFRy and delta_yAC_TMP */
+	if ( _nC > 0 )
+		size += 8 * Arena::getRealArraySize( _nC );
+
+	return size;
+}
+
+
 /*
  *	r e s e t
  */
@@ -230,7 +246,7 @@ returnValue QProblem::reset( )
 	constraintProduct = 0;
 
 	/* 5) Reset flipper object */
-	flipper.init( (unsigned int)nV,(unsigned int)nC );
+	flipper.init( (unsigned int)nV,(unsigned int)nC,arena );
 
 	return SUCCESSFUL_RETURN;
 }
@@ -435,6 +451,8 @@ returnValue QProblem::hotstart(	const real_t* const g_new,
 								const Bounds* const guessedBounds, const Constraints* const guessedConstraints
 								)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, nActiveFar;
 	int nV = getNV ();
 	int nC = getNC ();
@@ -505,10 +523,10 @@ returnValue QProblem::hotstart(	const real_t* const g_new,
 	}
 	else
 	{
-		real_t *ub_new_far = new real_t[nV];
-		real_t *lb_new_far = new real_t[nV];
-		real_t *ubA_new_far = new real_t[nC];
-		real_t *lbA_new_far = new real_t[nC];
+		real_t *ub_new_far = workspace.getRealArray( nV );
+		real_t *lb_new_far = workspace.getRealArray( nV );
+		real_t *ubA_new_far = workspace.getRealArray( nC );
+		real_t *lbA_new_far = workspace.getRealArray( nC );
 
 		/* possibly extend initial far bounds to largest bound/constraint data */
 		if (ub_new)
@@ -617,8 +635,6 @@ returnValue QProblem::hotstart(	const real_t* const g_new,
 			/* add time to setup auxiliary QP */
 			if ( cputime != 0 )
 				*cputime = cputime_needed + auxTime;
-			delete[] lbA_new_far; delete[] ubA_new_far;
-			delete[] lb_new_far; delete[] ub_new_far;
 	}
 
 	return ( returnvalue != SUCCESSFUL_RETURN ) ? THROWERROR( returnvalue ) : returnvalue;
@@ -711,6 +727,8 @@ returnValue QProblem::solveCurrentEQP(	const int n_rhs,
 										real_t* y_out
 										)
 {
+	WorkspaceScope scope( workspace );
+
 	if ( ( x_out == 0 ) || ( y_out == 0 ) )
 		return THROWERROR( RET_INVALID_ARGUMENTS );
 
@@ -722,10 +740,10 @@ returnValue QProblem::solveCurrentEQP(	const int n_rhs,
 	int nFX = getNFX( );
 	int nAC = getNAC( );
 
-	real_t *delta_xFX = new real_t[nFX];
-	real_t *delta_xFR = new real_t[nFR];
-	real_t *delta_yAC = new real_t[nAC];
-	real_t *delta_yFX = new real_t[nFX];
+	real_t *delta_xFX = workspace.getRealArray( nFX );
+	real_t *delta_xFR = workspace.getRealArray( nFR );
+	real_t *delta_yAC = workspace.getRealArray( nAC );
+	real_t *delta_yFX = workspace.getRealArray( nFX );
 
 	/* 1) Determine index arrays. */
 	int* FR_idx;
@@ -764,11 +782,6 @@ returnValue QProblem::solveCurrentEQP(	const int n_rhs,
 	}
 
 
-	delete[] delta_yFX;
-	delete[] delta_yAC;
-	delete[] delta_xFR;
-	delete[] delta_xFX;
-
 	return returnvalue;
 }
 
@@ -1058,79 +1071,79 @@ returnValue QProblem::clear( )
 
 	if ( lbA != 0 )
 	{
-		delete[] lbA;
+		freeRealArray( arena,lbA );
 		lbA = 0;
 	}
 
 	if ( ubA != 0 )
 	{
-		delete[] ubA;
+		freeRealArray( arena,ubA );
 		ubA = 0;
 	}
 
 	if ( T != 0 )
 	{
-		delete[] T;
+		freeRealArray( arena,T );
 		T = 0;
 	}
 
 	if ( Q != 0 )
 	{
-		delete[] Q;
+		freeRealArray( arena,Q );
 		Q = 0;
 	}
 
 	if ( Ax != 0 )
 	{
-		delete[] Ax;
+		freeRealArray( arena,Ax );
 		Ax = 0;
 	}
 
 	if ( Ax_l != 0 )
 	{
-		delete[] Ax_l;
+		freeRealArray( arena,Ax_l );
 		Ax_l = 0;
 	}
 
 	if ( Ax_u != 0 )
 	{
-		delete[] Ax_u;
+		freeRealArray( arena,Ax_u );
 		Ax_u = 0;
 	}
 
 	if ( tempA != 0 )
 	{
-		delete[] tempA;
+		freeRealArray( arena,tempA );
 		tempA = 0;
 	}
 
 	if ( ZFR_delta_xFRz != 0 )
 	{
-		delete[] ZFR_delta_xFRz;
+		freeRealArray( arena,ZFR_delta_xFRz );
 		ZFR_delta_xFRz = 0;
 	}
 
 	if ( delta_xFRy != 0 )
 	{
-		delete[] delta_xFRy;
+		freeRealArray( arena,delta_xFRy );
 		delta_xFRy = 0;
 	}
 
 	if ( delta_xFRz != 0 )
 	{
-		delete[] delta_xFRz;
+		freeRealArray( arena,delta_xFRz );
 		delta_xFRz = 0;
 	}
 
 	if ( tempB != 0 )
 	{
-		delete[] tempB;
+		freeRealArray( arena,tempB );
 		tempB = 0;
 	}
 
 	if ( delta_yAC_TMP != 0 )
 	{
-		delete[] delta_yAC_TMP;
+		freeRealArray( arena,delta_yAC_TMP );
 		delta_yAC_TMP = 0;
 	}
 
@@ -1180,7 +1193,7 @@ returnValue QProblem::copy(	const QProblem& rhs
 
 	if ( rhs.y != 0 )
 	{
-		delete[] y; /* y of no constraints version too short! */
+		freeRealArray( arena,y ); /* y of no constraints version too short! */
 		y = new real_t[_nV+_nC];
 		memcpy( y,rhs.y,(_nV+_nC)*sizeof(real_t) );
 	}
@@ -1443,6 +1456,8 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 								BooleanType isFirstCall
 								)
 {
+	WorkspaceScope scope( workspace );
+
 	int iter;
 	int nV  = getNV( );
 	int nC  = getNC( );
@@ -1465,16 +1480,16 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 	/* I) PREPARATIONS */
 	/* 1) Allocate delta vectors of gradient and (constraints') bounds,
 	 *    index arrays and step direction arrays. */
-	real_t* delta_xFR = new real_t[nV];
-	real_t* delta_xFX = new real_t[nV];
-	real_t* delta_yAC = new real_t[nC];
-	real_t* delta_yFX = new real_t[nV];
+	real_t* delta_xFR = workspace.getRealArray( nV );
+	real_t* delta_xFX = workspace.getRealArray( nV );
+	real_t* delta_yAC = workspace.getRealArray( nC );
+	real_t* delta_yFX = workspace.getRealArray( nV );
 
-	real_t* delta_g   = new real_t[nV];
-	real_t* delta_lb  = new real_t[nV];
-	real_t* delta_ub  = new real_t[nV];
-	real_t* delta_lbA = new real_t[nC];
-	real_t* delta_ubA = new real_t[nC];
+	real_t* delta_g   = workspace.getRealArray( nV );
+	real_t* delta_lb  = workspace.getRealArray( nV );
+	real_t* delta_ub  = workspace.getRealArray( nV );
+	real_t* delta_lbA = workspace.getRealArray( nC );
+	real_t* delta_ubA = workspace.getRealArray( nC );
 
 	BooleanType Delta_bC_isZero, Delta_bB_isZero;
 
@@ -1535,9 +1550,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 											);
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -1554,9 +1566,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 												);
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -1574,9 +1583,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 									);
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -1604,9 +1610,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 			if ( cputime != 0 )
 				*cputime = getCPUtime( ) - starttime;
 
-			delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
-
 			return SUCCESSFUL_RETURN;
 		}
 
@@ -1614,9 +1617,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 		returnvalue = changeActiveSet( BC_idx,BC_status,BC_isBound );
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -1644,8 +1644,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 			returnvalue = computeProjectedCholesky( );
 			if (returnvalue != SUCCESSFUL_RETURN)
 			{
-				delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-				delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
 				return returnvalue;
 			}
 		}
@@ -1667,9 +1665,6 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 		}
 	}
 
-	delete[] delta_yAC; delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-	delete[] delta_ub; delete[] delta_lb; delete[] delta_ubA; delete[] delta_lbA; delete[] delta_g;
-
 	/* stop runtime measurement */
 	if ( cputime != 0 )
 		*cputime = getCPUtime( ) - starttime;
@@ -1703,6 +1698,8 @@ returnValue QProblem::solveRegularisedQP(	const real_t* const g_new,
 											BooleanType isFirstCall
 											)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, step;
 	int nV = getNV( );
 
@@ -1748,7 +1745,7 @@ returnValue QProblem::solveRegularisedQP(	const real_t* const g_new,
 
 
 	/* II) PERFORM SUCCESSIVE REGULARISATION STEPS */
-	real_t* gMod = new real_t[nV];
+	real_t* gMod = workspace.getRealArray( nV );
 
 	for( step=0; step<options.numRegularisationSteps; ++step )
 	{
@@ -1778,8 +1775,6 @@ returnValue QProblem::solveRegularisedQP(	const real_t* const g_new,
 		/* Only continue if QP solution has been successful. */
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] gMod;
-
 			if ( cputime != 0 )
 				*cputime = cputime_total;
 
@@ -1793,8 +1788,6 @@ returnValue QProblem::solveRegularisedQP(	const real_t* const g_new,
 	for( i=0; i<nV; ++i )
 		g[i] = g_new[i];
 
-	delete[] gMod;
-
 	if ( cputime != 0 )
 		*cputime = cputime_total;
 
@@ -1906,8 +1899,6 @@ returnValue QProblem::computeProjectedCholesky( )
 	int nV  = getNV( );
 	int nZ  = getNZ( );
 
-	SymSparseMat* Id;
-
 	/* Revert to unprotected Cholesky decomposition */
 	if ( getNFX() + getNAC() == 0 )
 		return QProblemB::computeCholesky( );
@@ -1933,9 +1924,7 @@ returnValue QProblem::computeProjectedCholesky( )
 		case HST_ZERO:
 			if ( usingRegularisation() == BT_TRUE )
 			{
-				Id = createDiagSparseMat( nV, regVal );
-				Id->bilinear(bounds.getFree(), nZ, Q, nV, R, nV);
-				delete Id;
+				computeProjectedDiagHessian( regVal );
 			}
 			else
 			{
@@ -1946,9 +1935,7 @@ returnValue QProblem::computeProjectedCholesky( )
 			break;
 			
 		case HST_IDENTITY:
-			Id = createDiagSparseMat( nV, 1.0 );
-			Id->bilinear(bounds.getFree(), nZ, Q, nV, R, nV);
-			delete Id;
+			computeProjectedDiagHessian( 1.0 );
 			break;
 
 		default:
@@ -1996,6 +1983,36 @@ returnValue QProblem::computeProjectedCholesky( )
 }
 
 
+/*
+ *	c o m p u t e P r o j e c t e d D i a g H e s s i a n
+ */
+returnValue QProblem::computeProjectedDiagHessian( real_t diagVal )
+{
+	int i, j, col;
+	int nV  = getNV( );
+	int nZ  = getNZ( );
+
+	/* Same result (and summation order) as the bilinear form of a diagonal
+	 * SymSparseMat, without creating the matrix: free columns in ascending order. */
+	for( col=0; col<nV; ++col )
+	{
+		if ( bounds.getStatus( col ) != ST_INACTIVE )
+			continue;
+
+		for( i=0; i<nZ; ++i )
+			for( j=i; j<nZ; ++j )
+				R[i*nV+j] += diagVal * QQ(col,i) * QQ(col,j);
+	}
+
+	/* fill lower triangle */
+	for( i=0; i<nZ; ++i )
+		for( j=i; j<nZ; ++j )
+			R[j*nV+i] = R[i*nV+j];
+
+	return SUCCESSFUL_RETURN;
+}
+
+
 /*
  *	s e t u p I n i t i a l C h o l e s k y
  */
@@ -2686,6 +2703,8 @@ returnValue QProblem::addConstraint(	int number, SubjectToStatus C_status,
 										BooleanType ensureLI
 										)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, j, ii;
 
 	/* consistency checks */
@@ -2745,8 +2764,8 @@ returnValue QProblem::addConstraint(	int number, SubjectToStatus C_status,
 	int* FR_idx;
 	bounds.getFree( )->getNumberArray( &FR_idx );
 
-	real_t* aFR = new real_t[nFR];
-	real_t* wZ = new real_t[nZ];
+	real_t* aFR = workspace.getRealArray( nFR );
+	real_t* wZ = workspace.getRealArray( nZ );
 	for( i=0; i<nZ; ++i )
 		wZ[i] = 0.0;
 
@@ -2776,9 +2795,6 @@ returnValue QProblem::addConstraint(	int number, SubjectToStatus C_status,
 		}
 	}
 
-	delete[] aFR;
-
-
 	real_t c, s, nu;
 
 	if ( nZ > 0 )
@@ -2827,9 +2843,6 @@ returnValue QProblem::addConstraint(	int number, SubjectToStatus C_status,
 		}
 	}
 
-	delete[] wZ;
-
-
 	/* IV) UPDATE INDICES */
 	tabularOutput.idxAddC = number;
 	if ( constraints.moveInactiveToActive( number,C_status ) != SUCCESSFUL_RETURN )
@@ -2846,6 +2859,8 @@ returnValue QProblem::addConstraint(	int number, SubjectToStatus C_status,
  */
 returnValue QProblem::addConstraint_checkLI( int number )
 {
+	WorkspaceScope scope( workspace );
+
 	returnValue returnvalue = RET_LINEARLY_DEPENDENT;
 
 	int i, j, ii;
@@ -2870,18 +2885,18 @@ returnValue QProblem::addConstraint_checkLI( int number )
 
 		int *FX_idx, *AC_idx, *IAC_idx;
 
-		real_t *delta_g   = new real_t[nV];
-		real_t *delta_xFX = new real_t[nFX];
-		real_t *delta_xFR = new real_t[nFR];
-		real_t *delta_yAC = new real_t[nAC];
-		real_t *delta_yFX = new real_t[nFX];
+		real_t *delta_g   = workspace.getRealArray( nV );
+		real_t *delta_xFX = workspace.getRealArray( nFX );
+		real_t *delta_xFR = workspace.getRealArray( nFR );
+		real_t *delta_yAC = workspace.getRealArray( nAC );
+		real_t *delta_yFX = workspace.getRealArray( nFX );
 
 		bounds.getFixed( )->getNumberArray( &FX_idx );
 		constraints.getActive( )->getNumberArray( &AC_idx );
 		constraints.getInactive( )->getNumberArray( &IAC_idx );
 
 		int dim = (nC>nV)?nC:nV;
-		real_t *nul = new real_t[dim];
+		real_t *nul = workspace.getRealArray( dim );
 		for (ii = 0; ii < dim; ++ii)
 			nul[ii]=0.0;
 
@@ -2891,7 +2906,6 @@ returnValue QProblem::addConstraint_checkLI( int number )
 											  nul, nul, nul, nul,
 											  BT_FALSE, BT_FALSE,
 											  delta_xFX, delta_xFR, delta_yAC, delta_yFX);
-		delete[] nul;
 
 		/* compute the weight in inf-norm */
 		real_t weight = 0.0;
@@ -2922,13 +2936,6 @@ returnValue QProblem::addConstraint_checkLI( int number )
 		/* relative test against zero in inf-norm */
 		if (zero > options.epsLITests * weight)
 			returnvalue = RET_LINEARLY_INDEPENDENT;
-
-		delete[] delta_yFX;
-		delete[] delta_yAC;
-		delete[] delta_xFR;
-		delete[] delta_xFX;
-		delete[] delta_g;
-
 	}
 	else
 	{
@@ -2938,7 +2945,7 @@ returnValue QProblem::addConstraint_checkLI( int number )
 		 * space of Afr).
 		 */
 
-		real_t *Arow = new real_t[nFR];
+		real_t *Arow = workspace.getRealArray( nFR );
 		A->getRow(number, bounds.getFree(), 1.0, Arow);
 
 		real_t sum, l2;
@@ -2963,8 +2970,6 @@ returnValue QProblem::addConstraint_checkLI( int number )
 				break;
 			}
 		}
-
-		delete[] Arow;
 	}
 
 	return THROWINFO( returnvalue );
@@ -2976,6 +2981,8 @@ returnValue QProblem::addConstraint_checkLI( int number )
  */
 returnValue QProblem::addConstraint_ensureLI( int number, SubjectToStatus C_status )
 {
+	WorkspaceScope scope( workspace );
+
 	int i, j, ii, jj;
 	int nV  = getNV( );
 	int nFR = getNFR( );
@@ -3005,11 +3012,11 @@ returnValue QProblem::addConstraint_ensureLI( int number, SubjectToStatus C_stat
 	int* FX_idx;
 	bounds.getFixed( )->getNumberArray( &FX_idx );
 
-	real_t* xiC = new real_t[nAC];
-	real_t* xiC_TMP = new real_t[nAC];
-	real_t* xiB = new real_t[nFX];
-	real_t* Arow = new real_t[nFR];
-	real_t* num = new real_t[nV];
+	real_t* xiC = workspace.getRealArray( nAC );
+	real_t* xiC_TMP = workspace.getRealArray( nAC );
+	real_t* xiB = workspace.getRealArray( nFX );
+	real_t* Arow = workspace.getRealArray( nFR );
+	real_t* num = workspace.getRealArray( nV );
 
 	returnValue returnvalue = SUCCESSFUL_RETURN;
 
@@ -3148,12 +3155,6 @@ returnValue QProblem::addConstraint_ensureLI( int number, SubjectToStatus C_stat
 	}
 
 farewell:
-	delete[] num;
-	delete[] Arow;
-	delete[] xiB;
-	delete[] xiC_TMP;
-	delete[] xiC;
-
 	getGlobalMessageHandler( )->throwInfo( RET_LI_RESOLVED,0,__FUNCTION__,__FILE__,__LINE__,VS_VISIBLE );
 
 	return ( (returnvalue != SUCCESSFUL_RETURN) && (returnvalue != RET_ENSURELI_FAILED_NOINDEX ) ) ? THROWERROR (returnvalue) : returnvalue;
@@ -3169,6 +3170,8 @@ returnValue QProblem::addBound(	int number, SubjectToStatus B_status,
 								BooleanType ensureLI
 								)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, j, ii;
 
 	/* consistency checks */
@@ -3237,7 +3240,7 @@ returnValue QProblem::addBound(	int number, SubjectToStatus B_status,
 	int* FR_idx;
 	bounds.getFree( )->getNumberArray( &FR_idx );
 
-	real_t* w = new real_t[nFR];
+	real_t* w = workspace.getRealArray( nFR );
 
 
 	/* III) ADD NEW ACTIVE BOUND TO TOP OF MATRIX T: */
@@ -3273,7 +3276,7 @@ returnValue QProblem::addBound(	int number, SubjectToStatus B_status,
 	if ( nAC > 0 )	  /* ( nAC == 0 ) <=> ( nZ == nFR ) <=> Y and T are empty => nothing to do */
 	{
 		/* store new column a in a temporary vector instead of shifting T one column to the left */
-		real_t* tmp = new real_t[nAC];
+		real_t* tmp = workspace.getRealArray( nAC );
 		for( i=0; i<nAC; ++i )
 			tmp[i] = 0.0;
 
@@ -3306,13 +3309,8 @@ returnValue QProblem::addBound(	int number, SubjectToStatus B_status,
 			for( i=(nFR-2-j); i<nAC; ++i )
 				applyGivens( c,s,nu,TT(i,1+tcol-nZ+j),tmp[i], tmp[i],TT(i,1+tcol-nZ+j) );
 		}
-
-		delete[] tmp;
 	}
 
-	delete[] w;
-
-
 	if ( ( updateCholesky == BT_TRUE ) &&
 		 ( hessianType != HST_ZERO )   && ( hessianType != HST_IDENTITY ) )
 	{
@@ -3346,6 +3344,8 @@ returnValue QProblem::addBound(	int number, SubjectToStatus B_status,
  */
 returnValue QProblem::addBound_checkLI( int number )
 {
+	WorkspaceScope scope( workspace );
+
 	int i, ii;
 	int nV  = getNV( );  /* for QQ() macro */
 	int nFR = getNFR( );
@@ -3368,18 +3368,18 @@ returnValue QProblem::addBound_checkLI( int number )
 		 * "zero". We then check linear independence relative to this estimate.
 		 */
 
-		real_t *delta_g   = new real_t[nV];
-		real_t *delta_xFX = new real_t[nFX];
-		real_t *delta_xFR = new real_t[nFR];
-		real_t *delta_yAC = new real_t[nAC];
-		real_t *delta_yFX = new real_t[nFX];
+		real_t *delta_g   = workspace.getRealArray( nV );
+		real_t *delta_xFX = workspace.getRealArray( nFX );
+		real_t *delta_xFR = workspace.getRealArray( nFR );
+		real_t *delta_yAC = workspace.getRealArray( nAC );
+		real_t *delta_yFX = workspace.getRealArray( nFX );
 
 		for (ii = 0; ii < nV; ++ii)
 			delta_g[ii] = 0.0;
 		delta_g[number] = 1.0;	/* sign doesn't matter here */
 
 		int dim = (nC>nV)?nC:nV;
-		real_t *nul = new real_t[dim];
+		real_t *nul = workspace.getRealArray( dim );
 		for (ii = 0; ii < dim; ++ii)
 			nul[ii]=0.0;
 
@@ -3418,14 +3418,6 @@ returnValue QProblem::addBound_checkLI( int number )
 		/* relative test against zero in inf-norm */
 		if (zero > options.epsLITests * weight)
 			returnvalue = RET_LINEARLY_INDEPENDENT;
-
-		delete[] nul;
-		delete[] delta_yFX;
-		delete[] delta_yAC;
-		delete[] delta_xFR;
-		delete[] delta_xFX;
-		delete[] delta_g;
-
 	}
 	else
 	{
@@ -3455,6 +3447,8 @@ returnValue QProblem::addBound_checkLI( int number )
  */
 returnValue QProblem::addBound_ensureLI( int number, SubjectToStatus B_status )
 {
+	WorkspaceScope scope( workspace );
+
 	int i, ii;
 	int nV  = getNV( );
 	int nFX = getNFX( );
@@ -3486,10 +3480,10 @@ returnValue QProblem::addBound_ensureLI( int number, SubjectToStatus B_status )
 	int* AC_idx;
 	constraints.getActive( )->getNumberArray( &AC_idx );
 
-	real_t* xiC = new real_t[nAC];
-	real_t* xiC_TMP = new real_t[nAC];
-	real_t* xiB = new real_t[nFX];
-	real_t* num = new real_t[nV];
+	real_t* xiC = workspace.getRealArray( nAC );
+	real_t* xiC_TMP = workspace.getRealArray( nAC );
+	real_t* xiB = workspace.getRealArray( nFX );
+	real_t* num = workspace.getRealArray( nV );
 
 	real_t y_min = options.maxDualJump;
 	int y_min_number = -1;
@@ -3624,11 +3618,6 @@ returnValue QProblem::addBound_ensureLI( int number, SubjectToStatus B_status )
 	}
 
 farewell:
-	delete[] num;
-	delete[] xiB;
-	delete[] xiC_TMP;
-	delete[] xiC;
-
 	getGlobalMessageHandler( )->throwInfo( RET_LI_RESOLVED,0,__FUNCTION__,__FILE__,__LINE__,VS_VISIBLE );
 
 	return ( (returnvalue != SUCCESSFUL_RETURN) && (returnvalue != RET_ENSURELI_FAILED_NOINDEX ) ) ? THROWERROR (returnvalue) : returnvalue;
@@ -3645,6 +3634,8 @@ returnValue QProblem::removeConstraint(	int number,
 										BooleanType ensureNZC
 										)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, j, ii, jj;
 	returnValue returnvalue = SUCCESSFUL_RETURN;
 	BooleanType hasFlipped = BT_FALSE;
@@ -3695,7 +3686,7 @@ returnValue QProblem::removeConstraint(	int number,
 
 	/* save index sets and decompositions for flipping bounds strategy */
 	if ( ( exchangeHappened == BT_FALSE ) && ( options.enableFlippingBounds == BT_TRUE ) && ( allowFlipping == BT_TRUE ) )
-		flipper.set( &bounds,R,&constraints,Q,T );
+		flipper.set( &bounds,&constraints,Q,T );
 
 	/* I) REMOVE <number>th ROW FROM T,
 	 *    i.e. shift rows number+1 through nAC  upwards (instead of the actual
@@ -3744,8 +3735,8 @@ returnValue QProblem::removeConstraint(	int number,
 		/* III) UPDATE CHOLESKY DECOMPOSITION,
 		 *      calculate new additional column (i.e. [r sqrt(rho2)]')
 		 *      of the Cholesky factor R. */
-		real_t* Hz = new real_t[nFR];
-		real_t* z = new real_t[nFR];
+		real_t* Hz = workspace.getRealArray( nFR );
+		real_t* z = workspace.getRealArray( nFR );
 		real_t rho2 = 0.0;
 
 		/* 1) Calculate Hz = H*z, where z is the new rightmost column of Z
@@ -3753,14 +3744,13 @@ returnValue QProblem::removeConstraint(	int number,
 		for( j=0; j<nFR; ++j )
 			z[j] = QQ(FR_idx[j],nZ);
 		H->times(bounds.getFree(), bounds.getFree(), 1, 1.0, z, nFR, 0.0, Hz, nFR);
-		delete[] z;
 
 		if ( nZ > 0 )
 		{
-			real_t* ZHz = new real_t[nZ];
+			real_t* ZHz = workspace.getRealArray( nZ );
 			for ( i=0; i<nZ; ++i )
 				ZHz[i] = 0.0;
-			real_t* r = new real_t[nZ];
+			real_t* r = workspace.getRealArray( nZ );
 
 			/* 2) Calculate ZHz = Z'*Hz (old Z). */
 			for( j=0; j<nFR; ++j )
@@ -3774,7 +3764,6 @@ returnValue QProblem::removeConstraint(	int number,
 			/* 3) Calculate r = R^-T * ZHz. */
 			if ( backsolveR( ZHz,BT_TRUE,r ) != SUCCESSFUL_RETURN )
 			{
-				delete[] Hz; delete[] r; delete[] ZHz;
 				return THROWERROR( RET_REMOVECONSTRAINT_FAILED );
 			}
 
@@ -3785,16 +3774,12 @@ returnValue QProblem::removeConstraint(	int number,
 				rho2 -= r[i]*r[i];
 				RR(i,nZ) = r[i];
 			}
-
-			delete[] r; delete[] ZHz;
 		}
 
 		/* 5) Store rho into R. */
 		for( j=0; j<nFR; ++j )
 			rho2 += QQ(FR_idx[j],nZ) * Hz[j];
 
-		delete[] Hz;
-
 		if ( ( options.enableFlippingBounds == BT_TRUE ) && ( allowFlipping == BT_TRUE ) && ( exchangeHappened == BT_FALSE ) )
 		{
 			if ( rho2 > options.epsFlipping )
@@ -3803,7 +3788,7 @@ returnValue QProblem::removeConstraint(	int number,
 			{
 				hessianType = HST_SEMIDEF;
 
-				flipper.get( &bounds,R,&constraints,Q,T );
+				flipper.get( &bounds,&constraints,Q,T );
 				constraints.flipFixed(number);
 				tabularOutput.idxAddC = number;
 				tabularOutput.excAddC = 2;
@@ -3881,6 +3866,8 @@ returnValue QProblem::removeBound(	int number,
 									BooleanType ensureNZC
 									)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, j, ii, jj;
 	returnValue returnvalue = SUCCESSFUL_RETURN;
 	int addIdx;
@@ -3920,7 +3907,7 @@ returnValue QProblem::removeBound(	int number,
 
 	/* save index sets and decompositions for flipping bounds strategy */
 	if ( ( options.enableFlippingBounds == BT_TRUE ) && ( allowFlipping == BT_TRUE ) && ( exchangeHappened == BT_FALSE ) )
-		flipper.set( &bounds,R,&constraints,Q,T );
+		flipper.set( &bounds,&constraints,Q,T );
 
 	/* I) UPDATE INDICES */
 	tabularOutput.idxRemB = number;
@@ -3946,7 +3933,7 @@ returnValue QProblem::removeBound(	int number,
 		int* AC_idx;
 		constraints.getActive( )->getNumberArray( &AC_idx );
 
-		real_t* tmp = new real_t[nAC];
+		real_t* tmp = workspace.getRealArray( nAC );
 		A->getCol(number, constraints.getActive(), 1.0, tmp);
 
 
@@ -3970,8 +3957,6 @@ returnValue QProblem::removeBound(	int number,
 				applyGivens( c,s,nu,QQ(ii,nZ+1+j),QQ(ii,nZ+j),QQ(ii,nZ+1+j),QQ(ii,nZ+j) );
 			}
 		}
-
-		delete[] tmp;
 	}
 
 
@@ -3987,8 +3972,8 @@ returnValue QProblem::removeBound(	int number,
 		if ( nFR > 0 )
 		{
 			/* Attention: Index list of free variables has already grown by one! */
-			real_t* Hz = new real_t[nFR+1];
-			real_t* z = new real_t[nFR+1];
+			real_t* Hz = workspace.getRealArray( nFR+1 );
+			real_t* z = workspace.getRealArray( nFR+1 );
 			/* 1) Calculate R'*r = Zfr'*Hfr*z1 + z2*Zfr'*h1 =: Zfr'*Hz + z2*Zfr'*h1 =: rhs and
 			 *    rho2 = z1'*Hfr*z1 + 2*z2*h1'*z1 + h2*z2^2 - r'*r =: z1'*Hz + 2*z2*h1'*z1 + h2*z2^2 - r'r */
 			for( j=0; j<nFR; ++j )
@@ -4000,8 +3985,8 @@ returnValue QProblem::removeBound(	int number,
 			
 			if ( nZ > 0 )
 			{
-				real_t* r = new real_t[nZ];
-				real_t* rhs = new real_t[nZ];
+				real_t* r = workspace.getRealArray( nZ );
+				real_t* rhs = workspace.getRealArray( nZ );
 				for( i=0; i<nZ; ++i )
 					rhs[i] = 0.0;
 
@@ -4017,8 +4002,6 @@ returnValue QProblem::removeBound(	int number,
 				/* 3) Calculate r = R^-T * rhs. */
 				if ( backsolveR( rhs,BT_TRUE,BT_TRUE,r ) != SUCCESSFUL_RETURN )
 				{
-					delete[] z;
-					delete[] Hz; delete[] r; delete[] rhs;
 					return THROWERROR( RET_REMOVEBOUND_FAILED );
 				}
 
@@ -4030,8 +4013,6 @@ returnValue QProblem::removeBound(	int number,
 					rho2 -= r[i]*r[i];
 					RR(i,nZ) = r[i];
 				}
-
-				delete[] rhs; delete[] r;
 			}
 
 			for( j=0; j<nFR; ++j )
@@ -4040,9 +4021,6 @@ returnValue QProblem::removeBound(	int number,
 							/* z1' * ( Hz + 2*z2*h1 ) */
 				rho2 += QQ(jj,nZ) * ( Hz[j] + 2.0*z2*z[j] );
 			}
-
-			delete[] z;
-			delete[] Hz;
 		}
 
 		/* 5) Store rho into R. */
@@ -4055,7 +4033,7 @@ returnValue QProblem::removeBound(	int number,
 				if ( hessianType != HST_ZERO )
 					hessianType = HST_SEMIDEF;
 
-				flipper.get( &bounds,R,&constraints,Q,T );
+				flipper.get( &bounds,&constraints,Q,T );
 				bounds.flipFixed(number);
 				tabularOutput.idxAddB = number;
 				tabularOutput.excAddB = 2;
@@ -4143,6 +4121,8 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 												SubjectToStatus &addStatus
 												)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, ii;
 	int addLBndIdx = -1, addLCnstrIdx = -1, addUBndIdx = -1, addUCnstrIdx = -1; /* exchange indices */
 	int *FX_idx, *AC_idx, *IAC_idx;
@@ -4159,10 +4139,10 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 	bounds.getFree( )->getNumberArray( &FR_idx );
 
 // 	real_t *delta_g   = new real_t[nV];
-	real_t *delta_xFX = new real_t[nFX];
-	real_t *delta_xFR = new real_t[nFR];
-	real_t *delta_yAC = new real_t[nAC];
-	real_t *delta_yFX = new real_t[nFX];
+	real_t *delta_xFX = workspace.getRealArray( nFX );
+	real_t *delta_xFR = workspace.getRealArray( nFR );
+	real_t *delta_yAC = workspace.getRealArray( nAC );
+	real_t *delta_yFX = workspace.getRealArray( nFX );
 
 	bounds.getFixed( )->getNumberArray( &FX_idx );
 	constraints.getActive( )->getNumberArray( &AC_idx );
@@ -4175,8 +4155,8 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 	if (removeBoundNotConstraint)
 	{
 		int dim = nV < nC ? nC : nV;
-		real_t *nul = new real_t[dim];
-		real_t *ek = new real_t[nV]; /* minus e_k (bound k is removed) */
+		real_t *nul = workspace.getRealArray( dim );
+		real_t *ek = workspace.getRealArray( nV ); /* minus e_k (bound k is removed) */
 		for (ii = 0; ii < dim; ++ii)
 			nul[ii]=0.0;
 		for (ii = 0; ii < nV; ++ii)
@@ -4186,13 +4166,11 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 		returnvalue = determineStepDirection (nul, nul, nul, ek, ek,
 											  BT_FALSE, BT_FALSE,
 											  delta_xFX, delta_xFR, delta_yAC, delta_yFX);
-		delete[] ek;
-		delete[] nul;
 	}
 	else
 	{
-		real_t *nul = new real_t[nV];
-		real_t *ek = new real_t[nC]; /* minus e_k (constraint k is removed) */
+		real_t *nul = workspace.getRealArray( nV );
+		real_t *ek = workspace.getRealArray( nC ); /* minus e_k (constraint k is removed) */
 		for (ii = 0; ii < nV; ++ii)
 			nul[ii]=0.0;
 		for (ii = 0; ii < nC; ++ii)
@@ -4203,8 +4181,6 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 											  ek, ek, nul, nul,
 											  BT_FALSE, BT_TRUE,
 											  delta_xFX, delta_xFR, delta_yAC, delta_yFX);
-		delete[] ek;
-		delete[] nul;
 	}
 
 	/* compute the weight in inf-norm */
@@ -4242,7 +4218,7 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 		/* bounds */
 
 		/* compress x-u */
-		real_t *x_W = new real_t[getMax(1,nFR)];
+		real_t *x_W = workspace.getRealArray( getMax(1,nFR) );
 		for (i = 0; i < nFR; i++)
 		{
 			ii = FR_idx[i];
@@ -4282,17 +4258,15 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 		for (i = 0; i < nFR; i++)
 			delta_xFR[i] = -delta_xFR[i];
 
-		delete[] x_W;
-
 		/* constraints */
 
 		/* compute As (compressed to inactive constraints) */
-		real_t *As = new real_t[nIAC];
+		real_t *As = workspace.getRealArray( nIAC );
 		A->times(constraints.getInactive(), bounds.getFixed(), 1, 1.0, delta_xFX, nFX, 0.0, As, nIAC);
 		A->times(constraints.getInactive(), bounds.getFree(), 1, 1.0, delta_xFR, nFR, 1.0, As, nIAC);
 
 		/* compress Ax_u */
-		real_t *Ax_W = new real_t[nIAC];
+		real_t *Ax_W = workspace.getRealArray( nIAC );
 		for (i = 0; i < nIAC; i++)
 		{
 			ii = IAC_idx[i];
@@ -4356,15 +4330,8 @@ returnValue QProblem::ensureNonzeroCurvature(	BooleanType removeBoundNotConstrai
 			/* change working set later */
 			exchangeHappened = BT_TRUE;
 		}
-
-		delete[] Ax_W;
-		delete[] As;
 	}
 
-	delete[] delta_yFX;
-	delete[] delta_yAC;
-	delete[] delta_xFR;
-	delete[] delta_xFX;
 // 	delete[] delta_g;
 
 	return returnvalue;
@@ -4846,6 +4813,8 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 									int& BC_idx, SubjectToStatus& BC_status, BooleanType& BC_isBound
 									)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, j, ii, jj;
 	int nV  = getNV( );
 	int nC  = getNC( );
@@ -4871,14 +4840,14 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 
 	int BC_idx_tmp = -1;
 
-	real_t* num = new real_t[ getMax( nV,nC ) ];
-	real_t* den = new real_t[ getMax( nV,nC ) ];
+	real_t* num = workspace.getRealArray( getMax( nV,nC ) );
+	real_t* den = workspace.getRealArray( getMax( nV,nC ) );
 
-	real_t* delta_Ax_l = new real_t[nC];
-	real_t* delta_Ax_u = new real_t[nC];
-	real_t* delta_Ax   = new real_t[nC];
+	real_t* delta_Ax_l = workspace.getRealArray( nC );
+	real_t* delta_Ax_u = workspace.getRealArray( nC );
+	real_t* delta_Ax   = workspace.getRealArray( nC );
 
-	real_t* delta_x = new real_t[nV];
+	real_t* delta_x = workspace.getRealArray( nV );
 	for( j=0; j<nFR; ++j )
 	{
 		jj = FR_idx[j];
@@ -4950,8 +4919,6 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 			{
 				if ( (*constraintProduct)( ii,delta_x, &(delta_Ax[ii]) ) != 0 )
 				{
-					delete[] den; delete[] num;
-					delete[] delta_Ax; delete[] delta_Ax_u; delete[] delta_Ax_l; delete[] delta_x;
 					return THROWERROR( RET_ERROR_IN_CONSTRAINTPRODUCT );
 				}
 			}
@@ -5051,11 +5018,6 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 		}
 	}
 
-	delete[] den;
-	delete[] num;
-	delete[] delta_x;
-
-
 	#ifndef __XPCTARGET__
 	char messageString[MAX_STRING_LENGTH];
 
@@ -5132,8 +5094,6 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 		#endif
 	}
 
-	delete[] delta_Ax; delete[] delta_Ax_u; delete[] delta_Ax_l;
-
 	return SUCCESSFUL_RETURN;
 }
 
@@ -87,75 +87,17 @@ QProblemB::QProblemB( )
 	delta_xFR_TMP = 0;
 
 	setPrintLevel( options.printLevel );
+
+	arena = 0;
 }
 
 
 /*
  *	Q P r o b l e m B
  */
-QProblemB::QProblemB( int _nV, HessianType _hessianType )
+QProblemB::QProblemB( int _nV, HessianType _hessianType, Arena* _arena )
 {
-	int i;
-
-	/* print copyright notice */
-	if (options.printLevel != PL_NONE)
-		printCopyrightNotice( );
-
-	/* consistency check */
-	if ( _nV <= 0 )
-	{
-		_nV = 1;
-		THROWERROR( RET_INVALID_ARGUMENTS );
-	}
-
-	/* reset global message handler */
-	getGlobalMessageHandler( )->reset( );
-
-	freeHessian = BT_FALSE;
-	H = 0;
-
-	g = new real_t[_nV];
-	for( i=0; i<_nV; ++i ) g[i] = 0.0;
-
-	lb = new real_t[_nV];
-	for( i=0; i<_nV; ++i ) lb[i] = 0.0;
-
-	ub = new real_t[_nV];
-	for( i=0; i<_nV; ++i ) ub[i] = 0.0;
-
-	bounds.init( _nV );
-
-	R = new real_t[_nV*_nV];
-	for( i=0; i<_nV*_nV; ++i ) R[i] = 0.0;
-	haveCholesky = BT_FALSE;
-
-	x = new real_t[_nV];
-	for( i=0; i<_nV; ++i ) x[i] = 0.0;
-
-	y = new real_t[_nV];
-	for( i=0; i<_nV; ++i ) y[i] = 0.0;
-
-	tau = 0.0;
-
-	hessianType = _hessianType;
-	regVal = 0.0;
-
-	infeasible  = BT_FALSE;
-	unbounded   = BT_FALSE;
-
-	status = QPS_NOTINITIALISED;
-
-	count = 0;
-
-	ramp0 = options.initialRamping;
-	ramp1 = options.finalRamping;
-	rampOffset = 0;
-
-	delta_xFR_TMP = new real_t[_nV];
-
-	setPrintLevel( options.printLevel );
-
-	flipper.init( (unsigned int)_nV );
+	construct( _nV,0,_hessianType,_arena );
 }
 
 
@@ -198,6 +140,15 @@ QProblemB& QProblemB::operator=( const QProblemB& rhs )
 }
 
 
+/*
+ *	g e t A r e n a S i z e
+ */
+unsigned int QProblemB::getArenaSize( int _nV )
+{
+	return getArenaSize( _nV,0 );
+}
+
+
 /*
  *	r e s e t
  */
@@ -233,7 +184,7 @@ returnValue QProblemB::reset( )
 	rampOffset = 0;
 
 	/* 4) Reset flipper object */
-	flipper.init( (unsigned int)nV );
+	flipper.init( (unsigned int)nV,0,arena );
 
 	return SUCCESSFUL_RETURN;
 }
@@ -410,6 +361,8 @@ returnValue QProblemB::hotstart(	const real_t* const g_new,
 									const Bounds* const guessedBounds
 									)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, nActiveFar;
 	int nV = getNV ();
 	real_t starttime = 0.0;
@@ -475,8 +428,8 @@ returnValue QProblemB::hotstart(	const real_t* const g_new,
 	}
 	else
 	{
-		real_t *ub_new_far = new real_t[nV];
-		real_t *lb_new_far = new real_t[nV];
+		real_t *ub_new_far = workspace.getRealArray( nV );
+		real_t *lb_new_far = workspace.getRealArray( nV );
 
 		/* possibly extend initial far bounds to largest bound/constraint data */
 		if (ub_new)
@@ -564,7 +517,6 @@ returnValue QProblemB::hotstart(	const real_t* const g_new,
 			/* add time to setup auxiliary QP */
 			if ( cputime != 0 )
 				*cputime = cputime_needed + auxTime;
-			delete[] lb_new_far; delete[] ub_new_far;
 	}
 
 	return ( returnvalue != SUCCESSFUL_RETURN ) ? THROWERROR( returnvalue ) : returnvalue;
@@ -1012,6 +964,120 @@ returnValue QProblemB::printOptions( ) const
  *  P R O T E C T E D                                                        *
  *****************************************************************************/
 
+/*
+ *	Q P r o b l e m B
+ */
+QProblemB::QProblemB( int _nV, int _nC, HessianType _hessianType, Arena* _arena )
+{
+	construct( _nV,_nC,_hessianType,_arena );
+}
+
+
+/*
+ *	c o n s t r u c t
+ */
+returnValue QProblemB::construct( int _nV, int _nC, HessianType _hessianType, Arena* _arena )
+{
+	int i;
+
+	/* print copyright notice */
+	if (options.printLevel != PL_NONE)
+		printCopyrightNotice( );
+
+	/* consistency check */
+	if ( _nV <= 0 )
+	{
+		_nV = 1;
+		THROWERROR( RET_INVALID_ARGUMENTS );
+	}
+
+	/* checked by derived classes */
+	if ( _nC < 0 )
+		_nC = 0;
+
+	/* reset global message handler */
+	getGlobalMessageHandler( )->reset( );
+
+	arena = _arena;
+
+	freeHessian = BT_FALSE;
+	H = 0;
+
+	g = allocateRealArray( arena,_nV );
+	for( i=0; i<_nV; ++i ) g[i] = 0.0;
+
+	lb = allocateRealArray( arena,_nV );
+	for( i=0; i<_nV; ++i ) lb[i] = 0.0;
+
+	ub = allocateRealArray( arena,_nV );
+	for( i=0; i<_nV; ++i ) ub[i] = 0.0;
+
+	bounds.init( _nV );
+
+	R = allocateRealArray( arena,_nV*_nV );
+	for( i=0; i<_nV*_nV; ++i ) R[i] = 0.0;
+	haveCholesky = BT_FALSE;
+
+	x = allocateRealArray( arena,_nV );
+	for( i=0; i<_nV; ++i ) x[i] = 0.0;
+
+	y = allocateRealArray( arena,_nV+_nC );
+	for( i=0; i<_nV+_nC; ++i ) y[i] = 0.0;
+
+	tau = 0.0;
+
+	hessianType = _hessianType;
+	regVal = 0.0;
+
+	infeasible  = BT_FALSE;
+	unbounded   = BT_FALSE;
+
+	status = QPS_NOTINITIALISED;
+
+	count = 0;
+
+	ramp0 = options.initialRamping;
+	ramp1 = options.finalRamping;
+	rampOffset = 0;
+
+	delta_xFR_TMP = allocateRealArray( arena,_nV );
+
+	setPrintLevel( options.printLevel );
+
+	flipper.init( (unsigned int)_nV,(unsigned int)_nC,arena );
+
+	workspace.init( QPOASES_WORKSPACE_SIZE( _nV,_nC ),arena );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t A r e n a S i z e
+ */
+unsigned int QProblemB::getArenaSize( int _nV, int _nC )
+{
+	int dimT = getMin( _nV,_nC ) * getMin( _nV,_nC );
+	unsigned int size = 0;
+
+	/* g, lb, ub, x, y, delta_xFR_TMP and R */
+	size += 5 * Arena::getRealArraySize( _nV );
+	size += Arena::getRealArraySize( _nV+_nC );
+	size += Arena::getRealArraySize( _nV*_nV );
+
+	/* range space columns of Q and active block of T of the flipper */
+	if ( _nC > 0 )
+		size += Arena::getRealArraySize( _nV*getMin( _nV,_nC ) );
+	if ( dimT > 0 )
+		size += Arena::getRealArraySize( dimT );
+
+	/* workspace */
+	size += Arena::getRealArraySize( QPOASES_WORKSPACE_SIZE( _nV,_nC ) );
+
+	return size;
+}
+
+
 /*
  *	c l e a r
  */
@@ -1025,43 +1091,43 @@ returnValue QProblemB::clear( )
 
 	if ( g != 0 )
 	{
-		delete[] g;
+		freeRealArray( arena,g );
 		g = 0;
 	}
 
 	if ( lb != 0 )
 	{
-		delete[] lb;
+		freeRealArray( arena,lb );
 		lb = 0;
 	}
 
 	if ( ub != 0 )
 	{
-		delete[] ub;
+		freeRealArray( arena,ub );
 		ub = 0;
 	}
 
 	if ( R != 0 )
 	{
-		delete[] R;
+		freeRealArray( arena,R );
 		R = 0;
 	}
 
 	if ( x != 0 )
 	{
-		delete[] x;
+		freeRealArray( arena,x );
 		x = 0;
 	}
 
 	if ( y != 0 )
 	{
-		delete[] y;
+		freeRealArray( arena,y );
 		y = 0;
 	}
 
 	if ( delta_xFR_TMP != 0 )
 	{
-		delete[] delta_xFR_TMP;
+		freeRealArray( arena,delta_xFR_TMP );
 		delta_xFR_TMP = 0;
 	}
 
@@ -1077,6 +1143,9 @@ returnValue QProblemB::copy(	const QProblemB& rhs
 {
 	unsigned int _nV = (unsigned int)rhs.getNV( );
 
+	/* copies keep their arrays on the heap */
+	arena = 0;
+
 	bounds = rhs.bounds;
 
 	freeHessian = rhs.freeHessian;
@@ -1158,6 +1227,8 @@ returnValue QProblemB::copy(	const QProblemB& rhs
 
 	flipper = rhs.flipper;
 
+	workspace = rhs.workspace;
+
 	return SUCCESSFUL_RETURN;
 }
 
@@ -2393,6 +2464,8 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 								BooleanType isFirstCall
 								)
 {
+	WorkspaceScope scope( workspace );
+
 	int iter;
 	int nV  = getNV( );
 
@@ -2413,13 +2486,13 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 	/* I) PREPARATIONS */
 	/* 1) Allocate delta vectors of gradient and bounds,
 	 *    index arrays and step direction arrays. */
-	real_t* delta_xFR = new real_t[nV];
-	real_t* delta_xFX = new real_t[nV];
-	real_t* delta_yFX = new real_t[nV];
+	real_t* delta_xFR = workspace.getRealArray( nV );
+	real_t* delta_xFX = workspace.getRealArray( nV );
+	real_t* delta_yFX = workspace.getRealArray( nV );
 
-	real_t* delta_g  = new real_t[nV];
-	real_t* delta_lb = new real_t[nV];
-	real_t* delta_ub = new real_t[nV];
+	real_t* delta_g  = workspace.getRealArray( nV );
+	real_t* delta_lb = workspace.getRealArray( nV );
+	real_t* delta_ub = workspace.getRealArray( nV );
 
 	returnValue returnvalue;
 	BooleanType Delta_bB_isZero;
@@ -2476,9 +2549,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 											);
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -2495,9 +2565,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 												);
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -2516,9 +2583,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 									);
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -2543,9 +2607,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 			if ( cputime != 0 )
 				*cputime = getCPUtime( ) - starttime;
 
-			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
-
 			return SUCCESSFUL_RETURN;
 		}
 
@@ -2554,9 +2615,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 		returnvalue = changeActiveSet( BC_idx,BC_status );
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-			delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
-
 			/* Assign number of working set recalculations and stop runtime measurement. */
 			nWSR = iter;
 			if ( cputime != 0 )
@@ -2584,8 +2642,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 			returnvalue = computeCholesky( );
 			if (returnvalue != SUCCESSFUL_RETURN)
 			{
-				delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-				delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
 				return returnvalue;
 			}
 		}
@@ -2605,9 +2661,6 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 			THROWERROR( RET_PRINT_ITERATION_FAILED ); /* do not pass this as return value! */
 	}
 
-	delete[] delta_yFX; delete[] delta_xFX; delete[] delta_xFR;
-	delete[] delta_ub; delete[] delta_lb; delete[] delta_g;
-
 	/* stop runtime measurement */
 	if ( cputime != 0 )
 		*cputime = getCPUtime( ) - starttime;
@@ -2640,6 +2693,8 @@ returnValue QProblemB::solveRegularisedQP(	const real_t* const g_new,
 											BooleanType isFirstCall
 											)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, step;
 	int nV = getNV( );
 
@@ -2686,7 +2741,7 @@ returnValue QProblemB::solveRegularisedQP(	const real_t* const g_new,
 
 
 	/* II) PERFORM SUCCESSIVE REGULARISATION STEPS */
-	real_t* gMod = new real_t[nV];
+	real_t* gMod = workspace.getRealArray( nV );
 
 	for( step=0; step<options.numRegularisationSteps; ++step )
 	{
@@ -2716,8 +2771,6 @@ returnValue QProblemB::solveRegularisedQP(	const real_t* const g_new,
 		/* Only continue if QP solution has been successful. */
 		if ( returnvalue != SUCCESSFUL_RETURN )
 		{
-			delete[] gMod;
-
 			if ( cputime != 0 )
 				*cputime = cputime_total;
 
@@ -2731,8 +2784,6 @@ returnValue QProblemB::solveRegularisedQP(	const real_t* const g_new,
 	for( i=0; i<nV; ++i )
 		g[i] = g_new[i];
 
-	delete[] gMod;
-
 	if ( cputime != 0 )
 		*cputime = cputime_total;
 
@@ -3196,6 +3247,8 @@ returnValue QProblemB::performStep(	const real_t* const delta_g,
 									int& BC_idx, SubjectToStatus& BC_status
 									)
 {
+	WorkspaceScope scope( workspace );
+
 	int i, ii;
 	int nV = getNV( );
 	int nFR = getNFR( );
@@ -3213,8 +3266,8 @@ returnValue QProblemB::performStep(	const real_t* const delta_g,
 
 	int BC_idx_tmp = -1;
 
-	real_t* num = new real_t[nV];
-	real_t* den = new real_t[nV];
+	real_t* num = workspace.getRealArray( nV );
+	real_t* den = workspace.getRealArray( nV );
 
 
 	/* I) DETERMINE MAXIMUM DUAL STEPLENGTH, i.e. ensure that
@@ -3275,10 +3328,6 @@ returnValue QProblemB::performStep(	const real_t* const delta_g,
 		}
 	}
 
-	delete[] den;
-	delete[] num;
-
-
 	#ifndef __XPCTARGET__
 	char messageString[MAX_STRING_LENGTH];
 
@@ -3537,6 +3586,8 @@ returnValue QProblemB::removeBound(	int number,
 									BooleanType updateCholesky
 									)
 {
+	WorkspaceScope scope( workspace );
+
 	int i;
 	int nV  = getNV( );
 	int nFR = getNFR( );
@@ -3553,7 +3604,7 @@ returnValue QProblemB::removeBound(	int number,
 
 	/* save index sets and decompositions for flipping bounds strategy */
 	if ( options.enableFlippingBounds == BT_TRUE )
-		flipper.set( &bounds,R );
+		flipper.set( &bounds );
 
 	/* I) UPDATE INDICES */
 	tabularOutput.idxRemB = number;
@@ -3573,8 +3624,8 @@ returnValue QProblemB::removeBound(	int number,
 		bounds.getFree( )->getNumberArray( &FR_idx );
 
 		/* 1) Calculate new column of cholesky decomposition. */
-		real_t* rhs = new real_t[nFR+1];
-		real_t* r   = new real_t[nFR];
+		real_t* rhs = workspace.getRealArray( nFR+1 );
+		real_t* r   = workspace.getRealArray( nFR );
 
 		real_t r0;
 		switch ( hessianType )
@@ -3602,7 +3653,6 @@ returnValue QProblemB::removeBound(	int number,
 
 		if ( backsolveR( rhs,BT_TRUE,BT_TRUE,r ) != SUCCESSFUL_RETURN )
 		{
-			delete[] rhs; delete[] r;
 			return THROWERROR( RET_REMOVEBOUND_FAILED );
 		}
 
@@ -3621,14 +3671,14 @@ returnValue QProblemB::removeBound(	int number,
 			{
 				hessianType = HST_SEMIDEF;
 
-				flipper.get( &bounds,R );
+				flipper.get( &bounds );
 				bounds.flipFixed(number);
 
 				switch (bounds.getStatus(number))
 				{
 					case ST_LOWER: lb[number] = ub[number]; break;
 					case ST_UPPER: ub[number] = lb[number]; break;
-					default: delete[] rhs; delete[] r; return THROWERROR( RET_MOVING_BOUND_FAILED );
+					default: return THROWERROR( RET_MOVING_BOUND_FAILED );
 				}
 
 			}
@@ -3639,19 +3689,15 @@ returnValue QProblemB::removeBound(	int number,
 				RR(nFR,nFR) = getSqrt( r0 );
 			else
 			{
-				delete[] rhs; delete[] r;
-
 				hessianType = HST_SEMIDEF;
 				return THROWERROR( RET_HESSIAN_NOT_SPD );
 			}
 		}
-
-		delete[] rhs; delete[] r;
 	}
 
 	if ( ( hessianType == HST_ZERO ) && ( options.enableFlippingBounds == BT_TRUE ) )
 	{
-		flipper.get( &bounds,R );
+		flipper.get( &bounds );
 		bounds.flipFixed(number);
 
 		switch (bounds.getStatus(number))
@@ -56,7 +56,7 @@ SQProblem::SQProblem( ) : QProblem( )
 /*
  *	S Q P r o b l e m
  */
-SQProblem::SQProblem( int _nV, int _nC, HessianType _hessianType ) : QProblem( _nV,_nC,_hessianType )
+SQProblem::SQProblem( int _nV, int _nC, HessianType _hessianType, Arena* _arena ) : QProblem( _nV,_nC,_hessianType,_arena )
 {
 }
 
@@ -420,8 +420,8 @@ returnValue SQProblem::setupNewAuxiliaryQP(	SymmetricMatrix *H_new, Matrix *A_ne
 
 	/* II) SETUP WORKING SETS AND MATRIX FACTORISATIONS: */
 	/* 1) Make a copy of current bounds/constraints ... */
-	Bounds      oldBounds      = bounds;
-	Constraints oldConstraints = constraints;
+	oldBounds      = bounds;
+	oldConstraints = constraints;
 
     /* we're trying to find an active set with positive definite null
      * space Hessian twice:
@@ -522,19 +522,45 @@ returnValue SQProblem::setupNewAuxiliaryQP(	const real_t* const H_new, const rea
 	DenseMatrix *dA = 0;
 	SymDenseMat *sH = 0;
 
-	if ( A_new != 0 )
-		dA = new DenseMatrix(nC, nV, nV, (real_t*) A_new);
-	else
-		return THROWERROR( RET_INVALID_ARGUMENTS );
+	/* Re-use the matrix objects set up by a previous call (if any);
+	 * they are not freed by setA()/setH() as they are flagged as not owned. */
+	if ( nC > 0 )
+	{
+		if ( A_new == 0 )
+			return THROWERROR( RET_INVALID_ARGUMENTS );
+
+		if ( ( freeConstraintMatrix == BT_TRUE ) && ( A != 0 ) )
+			dA = dynamic_cast<DenseMatrix*>( A );
+
+		if ( dA != 0 )
+		{
+			dA->init( nC, nV, nV, (real_t*) A_new );
+			freeConstraintMatrix = BT_FALSE;
+		}
+		else
+			dA = new DenseMatrix(nC, nV, nV, (real_t*) A_new);
+	}
 
 	if ( H_new != 0 )
-		sH = new SymDenseMat(nV, nV, nV, (real_t*) H_new);
+	{
+		if ( ( freeHessian == BT_TRUE ) && ( H != 0 ) )
+			sH = dynamic_cast<SymDenseMat*>( H );
+
+		if ( sH != 0 )
+		{
+			sH->init( nV, nV, nV, (real_t*) H_new );
+			freeHessian = BT_FALSE;
+		}
+		else
+			sH = new SymDenseMat(nV, nV, nV, (real_t*) H_new);
+	}
 
 	returnValue returnvalue = setupNewAuxiliaryQP( sH,dA, lb_new,ub_new,lbA_new,ubA_new );
 
 	if ( H_new != 0 )
 		freeHessian = BT_TRUE;
-	freeConstraintMatrix = BT_TRUE;
+	if ( nC > 0 )
+		freeConstraintMatrix = BT_TRUE;
 
 	return returnvalue;
 }
@@ -0,0 +1,360 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/SQProblemB.cpp
+ *
+ *	Implementation of the SQProblemB class which is able to use the newly
+ *	developed online active set strategy for parametric quadratic programming
+ *	with varying Hessian matrix and bounds only.
+ */
+
+
+#include <qpOASES/SQProblemB.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	S Q P r o b l e m B
+ */
+SQProblemB::SQProblemB( ) : QProblemB( )
+{
+}
+
+
+/*
+ *	S Q P r o b l e m B
+ */
+SQProblemB::SQProblemB( int _nV, HessianType _hessianType, Arena* _arena ) : QProblemB( _nV,_hessianType,_arena )
+{
+}
+
+
+/*
+ *	S Q P r o b l e m B
+ */
+SQProblemB::SQProblemB( const SQProblemB& rhs ) : QProblemB( rhs )
+{
+}
+
+
+/*
+ *	~ S Q P r o b l e m B
+ */
+SQProblemB::~SQProblemB( )
+{
+}
+
+
+/*
+ *	o p e r a t o r =
+ */
+SQProblemB& SQProblemB::operator=( const SQProblemB& rhs )
+{
+	if ( this != &rhs )
+	{
+		QProblemB::operator=( rhs );
+	}
+
+	return *this;
+}
+
+
+
+/*
+ * h o t s t a r t
+ */
+returnValue SQProblemB::hotstart(	SymmetricMatrix *H_new, const real_t* const g_new,
+									const real_t* const lb_new, const real_t* const ub_new,
+									int& nWSR, real_t* const cputime,
+									const Bounds* const guessedBounds
+									)
+{
+	if ( ( getStatus( ) == QPS_NOTINITIALISED )       ||
+		 ( getStatus( ) == QPS_PREPARINGAUXILIARYQP ) ||
+		 ( getStatus( ) == QPS_PERFORMINGHOMOTOPY )   )
+	{
+		return THROWERROR( RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED );
+	}
+
+
+	real_t starttime = 0.0;
+	real_t auxTime = 0.0;
+
+	if ( cputime != 0 )
+		starttime = getCPUtime( );
+
+
+	/* I) UPDATE QP MATRICES AND VECTORS */
+	if ( setupNewAuxiliaryQP( H_new,lb_new,ub_new ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+
+	/* II) PERFORM USUAL HOMOTOPY */
+
+	/* Allow only remaining CPU time for usual hotstart. */
+	if ( cputime != 0 )
+	{
+		auxTime = getCPUtime( ) - starttime;
+		*cputime -= auxTime;
+	}
+
+	returnValue returnvalue = QProblemB::hotstart( g_new,lb_new,ub_new, nWSR,cputime, guessedBounds );
+
+	if ( cputime != 0 )
+		*cputime += auxTime;
+
+	return returnvalue;
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue SQProblemB::hotstart(	const real_t* const H_new, const real_t* const g_new,
+									const real_t* const lb_new, const real_t* const ub_new,
+									int& nWSR, real_t* const cputime,
+									const Bounds* const guessedBounds
+									)
+{
+	if ( ( getStatus( ) == QPS_NOTINITIALISED )       ||
+		 ( getStatus( ) == QPS_PREPARINGAUXILIARYQP ) ||
+		 ( getStatus( ) == QPS_PERFORMINGHOMOTOPY )   )
+	{
+		return THROWERROR( RET_HOTSTART_FAILED_AS_QP_NOT_INITIALISED );
+	}
+
+	/* start runtime measurement */
+	real_t starttime = 0.0;
+	if ( cputime != 0 )
+		starttime = getCPUtime( );
+
+
+	/* I) UPDATE QP MATRICES AND VECTORS */
+	if ( setupNewAuxiliaryQP( H_new,lb_new,ub_new ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+
+	/* II) PERFORM USUAL HOMOTOPY */
+
+	/* Allow only remaining CPU time for usual hotstart. */
+	if ( cputime != 0 )
+		*cputime -= getCPUtime( ) - starttime;
+
+	returnValue returnvalue = QProblemB::hotstart( g_new,lb_new,ub_new, nWSR,cputime, guessedBounds );
+
+
+	/* stop runtime measurement */
+	if ( cputime != 0 )
+		*cputime = getCPUtime( ) - starttime;
+
+	return returnvalue;
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue SQProblemB::hotstart(	const real_t* const g_new,
+									const real_t* const lb_new, const real_t* const ub_new,
+									int& nWSR, real_t* const cputime,
+									const Bounds* const guessedBounds
+									)
+{
+	/* Call to hotstart function for fixed QP matrices. */
+	return QProblemB::hotstart( g_new,lb_new,ub_new, nWSR,cputime, guessedBounds );
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+/*
+ *	s e t u p N e w A u x i l i a r y Q P
+ */
+returnValue SQProblemB::setupNewAuxiliaryQP(	SymmetricMatrix *H_new,
+												const real_t *lb_new, const real_t *ub_new
+												)
+{
+	int i;
+	int nV = getNV( );
+	returnValue returnvalue;
+
+	if ( ( getStatus( ) == QPS_NOTINITIALISED )       ||
+		 ( getStatus( ) == QPS_PREPARINGAUXILIARYQP ) ||
+		 ( getStatus( ) == QPS_PERFORMINGHOMOTOPY )   )
+	{
+		return THROWERROR( RET_UPDATEMATRICES_FAILED_AS_QP_NOT_SOLVED );
+	}
+
+	status = QPS_PREPARINGAUXILIARYQP;
+
+
+	/* I) SETUP NEW QP MATRICES AND VECTORS: */
+	/* 1) Set new Hessian matrix, determine Hessian type and
+	 *    regularise new Hessian matrix if necessary. */
+	/* a) Setup new Hessian matrix and determine its type. */
+	if ( H_new != 0 )
+	{
+		setH( H_new );
+
+		hessianType = HST_UNKNOWN;
+		if ( determineHessianType( ) != SUCCESSFUL_RETURN )
+			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+		/* b) Regularise new Hessian if necessary. */
+		if ( ( hessianType == HST_ZERO ) ||
+			 ( hessianType == HST_SEMIDEF ) ||
+			 ( usingRegularisation( ) == BT_TRUE ) )
+		{
+			regVal = 0.0; /* reset previous regularisation */
+
+			if ( regulariseHessian( ) != SUCCESSFUL_RETURN )
+				return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+		}
+	}
+	else
+	{
+		/* if no Hessian is specified, keep previous trivial Hessian (HST_ZERO or HST_IDENTITY),
+		   otherwise abort */
+		if ( H != 0 )
+			return THROWERROR( RET_NO_HESSIAN_SPECIFIED );
+	}
+
+	/* 2) Setup QP gradient. */
+	if ( setupAuxiliaryQPgradient( ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+
+	/* II) SETUP WORKING SET AND CHOLESKY FACTORISATION: */
+	/* 1) Make a copy of current bounds ... */
+	oldBounds = bounds;
+
+	/* as in SQProblem, the second try moves all inactive variables to a bound:
+	 * the resulting Cholesky factor is empty and thus always exists */
+	int n_try;
+	for ( n_try = 0; n_try < 2; ++n_try )
+	{
+		if ( n_try > 0 )
+		{
+			for ( i=0; i<nV; ++i )
+				if ( oldBounds.getStatus( i ) == ST_INACTIVE )
+					oldBounds.setStatus( i,options.initialStatusBounds );
+		}
+
+		/*    ... reset them ... */
+		bounds.init( nV );
+
+		/*    ... and set them up afresh. */
+		if ( setupSubjectToType( lb_new,ub_new ) != SUCCESSFUL_RETURN )
+			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+		if ( bounds.setupAllFree( ) != SUCCESSFUL_RETURN )
+			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+		/* check for equalities that have become bounds */
+		for ( i=0; i<nV; ++i )
+		{
+			if ( ( oldBounds.getType( i ) == ST_EQUALITY ) && ( bounds.getType( i ) == ST_BOUNDED ) )
+			{
+				if ( ( oldBounds.getStatus( i ) == ST_LOWER ) && ( y[i] < 0.0 ) )
+					oldBounds.setStatus( i,ST_UPPER );
+				else if ( ( oldBounds.getStatus( i ) == ST_UPPER ) && ( y[i] > 0.0 ) )
+					oldBounds.setStatus( i,ST_LOWER );
+			}
+		}
+
+		/* 2) Setup old working set afresh ... */
+		if ( setupAuxiliaryWorkingSet( &oldBounds,BT_TRUE ) != SUCCESSFUL_RETURN )
+			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
+
+		/* 3) ... and factorise the Hessian projected onto its free variables. */
+		returnvalue = computeCholesky( );
+
+		/* leave the loop if the decomposition was successful */
+		if ( returnvalue == SUCCESSFUL_RETURN )
+			break;
+	}
+
+	/* adjust lb/ub if the old working set has been changed in the second try */
+	if ( n_try > 0 )
+		setupAuxiliaryQPbounds( BT_FALSE );
+
+	status = QPS_AUXILIARYQPSOLVED;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t u p N e w A u x i l i a r y Q P
+ */
+returnValue SQProblemB::setupNewAuxiliaryQP(	const real_t* const H_new,
+												const real_t *lb_new, const real_t *ub_new
+												)
+{
+	int nV = getNV( );
+
+	SymDenseMat *sH = 0;
+
+	/* Re-use the matrix object set up by a previous call (if any);
+	 * it is not freed by setH() as it is flagged as not owned. */
+	if ( H_new != 0 )
+	{
+		if ( ( freeHessian == BT_TRUE ) && ( H != 0 ) )
+			sH = dynamic_cast<SymDenseMat*>( H );
+
+		if ( sH != 0 )
+		{
+			sH->init( nV, nV, nV, (real_t*) H_new );
+			freeHessian = BT_FALSE;
+		}
+		else
+			sH = new SymDenseMat(nV, nV, nV, (real_t*) H_new);
+	}
+
+	returnValue returnvalue = setupNewAuxiliaryQP( sH, lb_new,ub_new );
+
+	if ( H_new != 0 )
+		freeHessian = BT_TRUE;
+
+	return returnvalue;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -91,10 +91,26 @@ SubjectTo::~SubjectTo( )
  */
 SubjectTo& SubjectTo::operator=( const SubjectTo& rhs )
 {
+	int i;
+
 	if ( this != &rhs )
 	{
-		clear( );
-		copy( rhs );
+		/* reuse the allocated memory if the number of bounds/constraints does not change */
+		if ( ( type != 0 ) && ( rhs.type != 0 ) && ( n == rhs.n ) )
+		{
+			noLower = rhs.noLower;
+			noUpper = rhs.noUpper;
+			for( i=0; i<n; ++i )
+			{
+				type[i]   = rhs.type[i];
+				status[i] = rhs.status[i];
+			}
+		}
+		else
+		{
+			clear( );
+			copy( rhs );
+		}
 	}
 
 	return *this;
@@ -112,22 +128,26 @@ returnValue SubjectTo::init(	int _n
 	if ( _n < 0 )
 		return THROWERROR( RET_INVALID_ARGUMENTS );
 
-	clear( );
+	/* reuse the allocated memory if the number of bounds/constraints does not change */
+	if ( ( type == 0 ) || ( n != _n ) )
+	{
+		clear( );
+
+		if ( _n > 0 )
+		{
+			type   = new SubjectToType[_n];
+			status = new SubjectToStatus[_n];
+		}
+	}
 
 	n = _n;
 	noLower = BT_TRUE;
 	noUpper = BT_TRUE;
 
-	if ( n > 0 )
+	for( i=0; i<n; ++i )
 	{
-		type   = new SubjectToType[n];
-		status = new SubjectToStatus[n];
-
-		for( i=0; i<n; ++i )
-		{
-			type[i]   = ST_UNKNOWN;
-			status[i] = ST_UNDEFINED;
-		}
+		type[i]   = ST_UNKNOWN;
+		status[i] = ST_UNDEFINED;
 	}
 
 	return SUCCESSFUL_RETURN;
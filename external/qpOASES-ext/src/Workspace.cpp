@@ -0,0 +1,188 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/Workspace.cpp
+ *
+ *	Implementation of the Workspace class designed to provide preallocated
+ *	temporary arrays to the QProblemB and QProblem classes.
+ */
+
+
+#include <qpOASES/Workspace.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	W o r k s p a c e
+ */
+Workspace::Workspace( )
+{
+	nBlocks = 0;
+	arena = 0;
+
+	init( );
+}
+
+
+/*
+ *	W o r k s p a c e
+ */
+Workspace::Workspace( int _size )
+{
+	nBlocks = 0;
+	arena = 0;
+
+	init( _size );
+}
+
+
+/*
+ *	W o r k s p a c e
+ */
+Workspace::Workspace( const Workspace& rhs )
+{
+	nBlocks = 0;
+	arena = 0;
+
+	init( rhs.getSize( ) );
+}
+
+
+/*
+ *	~ W o r k s p a c e
+ */
+Workspace::~Workspace( )
+{
+	clear( );
+}
+
+
+/*
+ *	o p e r a t o r =
+ */
+Workspace& Workspace::operator=( const Workspace& rhs )
+{
+	if ( this != &rhs )
+		init( rhs.getSize( ) );
+
+	return *this;
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue Workspace::init( int _size, Arena* _arena )
+{
+	if ( _size < 0 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	clear( );
+
+	arena = _arena;
+	currentBlock = 0;
+	top = 0;
+
+	if ( _size > 0 )
+	{
+		block[0] = allocateRealArray( arena,_size );
+		blockSize[0] = _size;
+		nBlocks = 1;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+/*
+ *	c l e a r
+ */
+returnValue Workspace::clear( )
+{
+	int i;
+
+	for( i=0; i<nBlocks; ++i )
+		freeRealArray( arena,block[i] );
+
+	nBlocks = 0;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t N e x t B l o c k
+ */
+real_t* Workspace::getNextBlock( int n )
+{
+	int next = ( nBlocks > 0 ) ? currentBlock+1 : 0;
+	int size;
+
+	if ( next >= QPOASES_WORKSPACE_MAXBLOCKS )
+	{
+		THROWERROR( RET_UNKNOWN_BUG );
+		return 0;
+	}
+
+	/* blocks following the one in use are not used, they can be re-allocated */
+	if ( ( next >= nBlocks ) || ( blockSize[next] < n ) )
+	{
+		size = ( next > 0 ) ? getMax( n,2*blockSize[next-1] ) : getMax( n,1 );
+
+		if ( next < nBlocks )
+			freeRealArray( arena,block[next] );
+		else
+			nBlocks = next+1;
+
+		block[next] = new real_t[size];
+		blockSize[next] = size;
+	}
+
+	currentBlock = next;
+	top = n;
+
+	return block[next];
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
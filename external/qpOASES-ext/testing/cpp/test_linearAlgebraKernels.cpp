@@ -0,0 +1,235 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2015 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file testing/cpp/test_linearAlgebraKernels.cpp
+ *
+ *	Micro-benchmark of the linear algebra kernels behind dgemm_ and dpotrf_
+ *	at the problem sizes of a hierarchical QP (nV = 30..80, nC = 50..400).
+ *	Compares the reference loops, the AVX2/FMA kernels and the dgemm_/dpotrf_
+ *	actually linked (replacement or system BLAS/LAPACK) and checks that all
+ *	of them agree.
+ */
+
+
+
+#include <cstdlib>
+#include <qpOASES.hpp>
+#include <qpOASES/LinearAlgebraKernels.hpp>
+#include <qpOASES/UnitTesting.hpp>
+
+
+USING_NAMESPACE_QPOASES
+
+
+/** Signature of dgemm_. */
+typedef void (*GemmFunction)(	const char*, const char*, const unsigned long*, const unsigned long*, const unsigned long*,
+								const double*, const double*, const unsigned long*, const double*, const unsigned long*,
+								const double*, double*, const unsigned long* );
+
+/** Signature of dpotrf_. */
+typedef void (*PotrfFunction)( const char*, const unsigned long*, double*, const unsigned long*, long* );
+
+
+/** Number of repetitions of each timed call. */
+const int nRuns = 2000;
+
+
+/** Returns a random number in [-1,1]. */
+double randomNumber( )
+{
+	return 2.0 * ( (double)rand( ) / (double)RAND_MAX ) - 1.0;
+}
+
+
+/** Times C = op(A)*B + beta*C, A being a row-major nC x nV matrix as stored by
+ *	DenseMatrix, and returns the average time per call in microseconds. */
+double timeGemm(	GemmFunction gemm, const char *trans, unsigned long m, unsigned long n, unsigned long k,
+					const double *A, unsigned long lda, const double *B, unsigned long ldb, double beta,
+					double *C, unsigned long ldc
+					)
+{
+	const double one = 1.0;
+	int i;
+
+	real_t t = getCPUtime( );
+	for ( i=0; i<nRuns; ++i )
+		gemm( trans, "NOTR", &m, &n, &k, &one, A, &lda, B, &ldb, &beta, C, &ldc );
+	t = getCPUtime( ) - t;
+
+	return 1.0e6 * t / (double)nRuns;
+}
+
+
+/** Times the Cholesky factorisation of the nV x nV matrix H and returns the
+ *	average time per call in microseconds; the factor is left in R. */
+double timePotrf( PotrfFunction potrf, unsigned long nV, const double *H, double *R )
+{
+	unsigned long i;
+	long info = 0;
+	int run;
+
+	real_t t = getCPUtime( );
+	for ( run=0; run<nRuns; ++run )
+	{
+		for ( i=0; i<nV*nV; ++i )
+			R[i] = H[i];
+		potrf( "U", &nV, R, &nV, &info );
+	}
+	t = getCPUtime( ) - t;
+
+	return ( info == 0 ) ? 1.0e6 * t / (double)nRuns : -1.0;
+}
+
+
+/** Returns the maximum absolute difference of two arrays. */
+double maxDifference( const double *x, const double *y, unsigned long n )
+{
+	double diff = 0.0;
+	unsigned long i;
+
+	for ( i=0; i<n; ++i )
+		if ( getAbs( x[i] - y[i] ) > diff )
+			diff = getAbs( x[i] - y[i] );
+
+	return diff;
+}
+
+
+/** Benchmark of the linear algebra kernels. */
+int main( )
+{
+	const unsigned long sizes[][2] = { {30,50}, {30,100}, {50,150}, {50,250}, {80,250}, {80,400} };
+	const int nSizes = sizeof(sizes) / sizeof(sizes[0]);
+	const int nKernels = 3;
+	const double TOL = 1e-10;
+
+	GemmFunction gemm[nKernels] = { dgemmReference, dgemm_, dgemm_ };
+	PotrfFunction potrf[nKernels] = { dpotrfReference, dpotrf_, dpotrf_ };
+	const char *kernelNames[nKernels] = { "reference", "AVX2/FMA", "linked" };
+	BooleanType useKernel[nKernels] = { BT_TRUE, BT_FALSE, BT_TRUE };
+
+	#ifdef QPOASES_AVX2_KERNELS
+	if ( haveAVX2Kernels( ) == BT_TRUE )
+	{
+		gemm[1] = dgemmAVX2;
+		potrf[1] = dpotrfAVX2;
+		useKernel[1] = BT_TRUE;
+	}
+	#endif
+
+	int s, kernel;
+	unsigned long i, j, l;
+
+	fprintf( stdFile, "   nV   nC  kernel       A*x [us]  A'*y [us]  A*X [us]  chol(H) [us]\n" );
+
+	for ( s=0; s<nSizes; ++s )
+	{
+		const unsigned long nV = sizes[s][0];
+		const unsigned long nC = sizes[s][1];
+
+		double *A = new double[nC*nV];	/* row-major, as in DenseMatrix */
+		double *X = new double[nV*nV];
+		double *y = new double[nC];
+		double *H = new double[nV*nV];
+		double *R = new double[nV*nV];
+		double *Rref = new double[nV*nV];
+		double *Ax = new double[nC*nV];
+		double *Axref = new double[nC*nV];
+		double *Aty = new double[nV];
+		double *Atyref = new double[nV];
+
+		for ( i=0; i<nC*nV; ++i )
+			A[i] = randomNumber( );
+		for ( i=0; i<nV*nV; ++i )
+			X[i] = randomNumber( );
+		for ( i=0; i<nC; ++i )
+			y[i] = randomNumber( );
+
+		/* H = A'*A + I is symmetric positive definite */
+		for ( i=0; i<nV; ++i )
+			for ( j=0; j<nV; ++j )
+			{
+				H[i*nV+j] = ( i == j ) ? 1.0 : 0.0;
+				for ( l=0; l<nC; ++l )
+					H[i*nV+j] += A[l*nV+i] * A[l*nV+j];
+			}
+
+		for ( kernel=0; kernel<nKernels; ++kernel )
+		{
+			if ( useKernel[kernel] == BT_FALSE )
+			{
+				fprintf( stdFile, " %4lu %4lu  %-10s   (not available)\n", nV, nC, kernelNames[kernel] );
+				continue;
+			}
+
+			/* A*x and A*X, computed as A'^T*x on the row-major storage as done by DenseMatrix::times */
+			double tAx = timeGemm( gemm[kernel], "TRANS", nC, 1, nV, A, nV, X, nV, 0.0, Ax, nC );
+			double tAX = timeGemm( gemm[kernel], "TRANS", nC, nV, nV, A, nV, X, nV, 0.0, Ax, nC );
+			/* A'*y, as done by DenseMatrix::transTimes */
+			double tAty = timeGemm( gemm[kernel], "NOTR", nV, 1, nC, A, nV, y, nC, 0.0, Aty, nV );
+			double tChol = timePotrf( potrf[kernel], nV, H, R );
+
+			fprintf( stdFile, " %4lu %4lu  %-10s %9.2f  %9.2f  %9.2f  %11.2f\n",
+					 nV, nC, kernelNames[kernel], tAx, tAty, tAX, tChol );
+
+			QPOASES_TEST_FOR_TRUE( tChol >= 0.0 )
+
+			if ( kernel == 0 )
+			{
+				for ( i=0; i<nC*nV; ++i )
+					Axref[i] = Ax[i];
+				for ( i=0; i<nV; ++i )
+					Atyref[i] = Aty[i];
+				for ( i=0; i<nV*nV; ++i )
+					Rref[i] = R[i];
+			}
+			else
+			{
+				/* compare the upper triangle only, the lower one is not referenced */
+				double diffR = 0.0;
+				for ( i=0; i<nV; ++i )
+					for ( j=i; j<nV; ++j )
+						if ( getAbs( R[i*nV+j] - Rref[i*nV+j] ) > diffR )
+							diffR = getAbs( R[i*nV+j] - Rref[i*nV+j] );
+
+				QPOASES_TEST_FOR_TOL( maxDifference( Ax, Axref, nC*nV ), TOL*nC )
+				QPOASES_TEST_FOR_TOL( maxDifference( Aty, Atyref, nV ), TOL*nC )
+				QPOASES_TEST_FOR_TOL( diffR, TOL*nC )
+			}
+		}
+
+		delete[] Atyref; delete[] Aty;
+		delete[] Axref; delete[] Ax;
+		delete[] Rref; delete[] R; delete[] H;
+		delete[] y; delete[] X; delete[] A;
+	}
+
+	return TEST_PASSED;
+}
+
+
+/*
+ *	end of file
+ */
@@ -96,6 +96,18 @@
          */
         Vector_type _bUpperBound;
 
+        /**
+         * @brief _A_generation is incremented whenever _Aeq or _Aineq change. It is meaningful
+         * only for constraints which set _tracks_generations to true
+         */
+        unsigned int _A_generation;
+
+        /**
+         * @brief _tracks_generations is true if the constraint increments _A_generation whenever
+         * _Aeq or _Aineq change: otherwise they are considered to change at every update
+         */
+        bool _tracks_generations;
+
         /**
          * @brief _log can be used to log internal Constraint variables
          * @param logger a shared pointer to a MatLogger
@@ -108,7 +120,8 @@
     public:
         Constraint(const std::string constraint_id,
                    const unsigned int x_size) :
-            _constraint_id(constraint_id), _x_size(x_size) {}
+            _constraint_id(constraint_id), _x_size(x_size),
+            _A_generation(0), _tracks_generations(false) {}
         virtual ~Constraint() {}
 
         const unsigned int getXSize() { return _x_size; }
@@ -168,6 +181,19 @@
         virtual bool isConstraint() { return this->isEqualityConstraint() ||
                                              this->isInequalityConstraint(); }
 
+        /**
+         * @brief getAGeneration
+         * @return a counter which is incremented whenever Aeq or Aineq change,
+         * if tracksGenerations() is true
+         */
+        unsigned int getAGeneration() const { return _A_generation; }
+
+        /**
+         * @brief tracksGenerations
+         * @return true if getAGeneration() can be used to know whether Aeq or Aineq changed
+         */
+        bool tracksGenerations() const { return _tracks_generations; }
+
         /**
          * @brief getTaskID return the task id
          * @return a string with the task id
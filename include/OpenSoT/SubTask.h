@@ -51,10 +51,19 @@
         TaskPtr _taskPtr;
         Indices _subTaskMap;
 
+        /**
+         * @brief _father_A_generation and _father_W_generation are the generations of A and W
+         * of the father task from which A and W have been generated
+         */
+        unsigned int _father_A_generation;
+        unsigned int _father_W_generation;
+
         virtual void _log(XBot::MatLogger::Ptr logger);
 
         void generateA();
 
+        void generateJacobianType();
+
         void generateHessianAtype();
 
         void generateb();
@@ -39,6 +39,23 @@
         HST_UNKNOWN                 /**< Hessian type is unknown. */
     };
 
+    /** Summarises the structures of the weight matrix of a Task, exploited to apply it without dense products */
+    enum WeightType
+    {
+        WT_IDENTITY,                /**< Weight is identity matrix. */
+        WT_DIAGONAL,                /**< Weight is a diagonal matrix. */
+        WT_DENSE,                   /**< Weight is a generic matrix. */
+        WT_UNKNOWN                  /**< Weight type is unknown, it is determined from the weight matrix. */
+    };
+
+    /** Summarises the structures of the Jacobian of a Task, exploited to avoid dense products with it */
+    enum JacobianType
+    {
+        JT_IDENTITY,                /**< Jacobian is identity matrix. */
+        JT_SELECTION,               /**< Every row of the Jacobian is a row of the identity matrix. */
+        JT_DENSE                    /**< Jacobian is a generic matrix. */
+    };
+
     /**
      * @brief Task represents a task in the form \f$T(A,b)\f$ where \f$A\f$ is the task error jacobian and \f$b\f$ is the task error
     */
@@ -82,6 +99,46 @@
          */
         Matrix_type _W;
 
+        /**
+         * @brief _weightType structure of _W, determined when unknown. Derived tasks which write _W
+         * directly, instead of calling setWeight(), have to set it accordingly (or to WT_UNKNOWN)
+         */
+        mutable WeightType _weightType;
+
+        /**
+         * @brief _jacobianType structure of _A, declared by the derived tasks whose _A keeps it
+         * on every update (JT_DENSE otherwise)
+         */
+        JacobianType _jacobianType;
+
+        /**
+         * @brief _jacobianSelection when _jacobianType is JT_SELECTION, the row i of _A is the
+         * row _jacobianSelection[i] of the identity matrix
+         */
+        std::vector<unsigned int> _jacobianSelection;
+
+        /**
+         * @brief _is_A_masked true when _A has been (partly) set to 0 by the active joints mask or by
+         * updating the task while not active, and it has not been rebuilt since: _A may not have
+         * the structure declared by _jacobianType
+         */
+        bool _is_A_masked;
+
+        /**
+         * @brief _A_generation, _b_generation and _W_generation are incremented whenever
+         * _A, _b or _W change: users of the task compare them with the values seen last time
+         * to skip the computations which depend on values which did not change
+         */
+        unsigned int _A_generation;
+        unsigned int _b_generation;
+        unsigned int _W_generation;
+
+        /**
+         * @brief _is_A_changed is set to true before calling _update(): derived tasks whose
+         * _update() leaves _A untouched set it to false, so that _A_generation is not incremented
+         */
+        bool _is_A_changed;
+
         /**
          * @brief _lambda error scaling,
          * NOTE:
@@ -165,6 +222,11 @@
          */
         Matrix_type _A_last_active;
 
+        /**
+         * @brief _is_A_last_active_masked value of _is_A_masked for _A_last_active
+         */
+        bool _is_A_last_active_masked;
+
     public:
         /**
          * @brief Task define a task in terms of Ax = b
@@ -177,6 +239,14 @@
         {
             _lambda = 1.0;
             _hessianType = HST_UNKNOWN;
+            _weightType = WT_UNKNOWN;
+            _jacobianType = JT_DENSE;
+            _is_A_masked = false;
+            _is_A_last_active_masked = false;
+            _A_generation = 0;
+            _b_generation = 0;
+            _W_generation = 0;
+            _is_A_changed = true;
             for(unsigned int i = 0; i < x_size; ++i)
                 _active_joints_mask[i] = true;
         }
@@ -192,6 +262,8 @@
             
             if(!_is_active && active_flag){
                 _A = _A_last_active;
+                _is_A_masked = _is_A_last_active_masked;
+                ++_A_generation;
             }
             
             _is_active = active_flag;
@@ -213,6 +285,43 @@
             return _A;
         }
 
+        /**
+         * @brief getJacobianType
+         * @return the structure of the A matrix of the task: JT_DENSE when the task
+         * is not active or some of its columns are masked
+         */
+        JacobianType getJacobianType() const {
+            if(!_is_active || _is_A_masked)
+                return JT_DENSE;
+            return _jacobianType;
+        }
+
+        /**
+         * @brief getJacobianSelection
+         * @return when getJacobianType() is JT_SELECTION, for each row of A the index of its nonzero (unit) column
+         */
+        const std::vector<unsigned int>& getJacobianSelection() const {
+            return _jacobianSelection;
+        }
+
+        /**
+         * @brief getAGeneration
+         * @return a counter which is incremented whenever the A matrix of the task changes
+         */
+        unsigned int getAGeneration() const { return _A_generation; }
+
+        /**
+         * @brief getbGeneration
+         * @return a counter which is incremented whenever the b vector of the task changes
+         */
+        unsigned int getbGeneration() const { return _b_generation; }
+
+        /**
+         * @brief getWeightGeneration
+         * @return a counter which is incremented whenever the weight of the task changes
+         */
+        unsigned int getWeightGeneration() const { return _W_generation; }
+
         /**
          * @brief getHessianAtype
          * @return the Hessian type
@@ -230,7 +339,17 @@
          * @return the product between W and A
          */
         const Matrix_type& getWA() const {
-            _WA.noalias() = _W*_A;
+            switch(getWeightType())
+            {
+            case WT_IDENTITY:
+                _WA = _A;
+                break;
+            case WT_DIAGONAL:
+                _WA.noalias() = _W.diagonal().asDiagonal()*_A;
+                break;
+            default:
+                _WA.noalias() = _W*_A;
+            }
             return _WA;
         }
 
@@ -248,7 +367,17 @@
          * @return the product between W and b
          */
         const Vector_type& getWb() const {
-            _Wb = _W*_b;
+            switch(getWeightType())
+            {
+            case WT_IDENTITY:
+                _Wb = _b;
+                break;
+            case WT_DIAGONAL:
+                _Wb.noalias() = _W.diagonal().asDiagonal()*_b;
+                break;
+            default:
+                _Wb.noalias() = _W*_b;
+            }
             return _Wb;
         }
 
@@ -258,6 +387,29 @@
          */
         const Matrix_type& getWeight() const { return _W; }
 
+        /**
+         * @brief getWeightType
+         * @return the structure of the weight of the task
+         */
+        WeightType getWeightType() const {
+            if(_weightType == WT_UNKNOWN)
+                _weightType = computeWeightType(_W);
+            return _weightType;
+        }
+
+        /**
+         * @brief computeWeightType determines the structure of a weight matrix
+         * @param W matrix weight
+         * @return WT_IDENTITY, WT_DIAGONAL or WT_DENSE
+         */
+        static WeightType computeWeightType(const Matrix_type& W) {
+            if(W.isIdentity())
+                return WT_IDENTITY;
+            if(W.isDiagonal())
+                return WT_DIAGONAL;
+            return WT_DENSE;
+        }
+
         /**
          * @brief setWeight sets the task weight.
          * Note the Weight needs to be positive definite.
@@ -270,6 +422,8 @@
             assert(W.rows() == this->getTaskSize());
             assert(W.cols() == W.rows());
             _W = W;
+            _weightType = computeWeightType(_W);
+            ++_W_generation;
         }
 
         /**
@@ -309,11 +463,20 @@
             
             for(typename std::list< ConstraintPtr >::iterator i = this->getConstraints().begin();
                 i != this->getConstraints().end(); ++i) (*i)->update(x);
+            _is_A_changed = true;
             this->_update(x);
+            ++_b_generation;
+
+            // an A rebuilt by the task is not masked anymore
+            if(_is_A_changed)
+                _is_A_masked = false;
             
             if(!_is_active){
                 _A_last_active = _A;
+                _is_A_last_active_masked = _is_A_masked;
                 _A.setZero(_A.rows(), _A.cols());
+                _is_A_masked = true;
+                ++_A_generation;
                 return;
             }
 
@@ -326,7 +489,14 @@
                 if(*active_joint == false) all_true = false;
             }
 
-            if(!all_true) applyActiveJointsMask(_A);
+            if(!all_true)
+            {
+                applyActiveJointsMask(_A);
+                _is_A_masked = true;
+            }
+
+            if(_is_A_changed)
+                ++_A_generation;
             
             
         }
@@ -356,6 +526,10 @@
                 _active_joints_mask = active_joints_mask;
 
                 applyActiveJointsMask(_A);
+                for(unsigned int i = 0; i < _active_joints_mask.size(); ++i)
+                    if(!_active_joints_mask[i])
+                        _is_A_masked = true;
+                ++_A_generation;
 
                 return true;
             }
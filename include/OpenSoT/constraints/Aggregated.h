@@ -23,6 +23,7 @@
 #include <boost/shared_ptr.hpp>
 #include <OpenSoT/utils/Piler.h>
 #include <list>
+#include <vector>
 
 using namespace OpenSoT::utils;
 
@@ -59,13 +60,10 @@ using namespace OpenSoT::utils;
             };
 
         protected:
-            VectorPiler _tmpupperBound;
-            VectorPiler _tmplowerBound;
-
             MatrixPiler _tmpAeq;
             VectorPiler _tmpbeq;
 
-            MatrixPiler _tmpAineq;
+            RowMajorMatrixPiler _tmpAineq;
             VectorPiler _tmpbUpperBound;
             VectorPiler _tmpbLowerBound;
 
@@ -73,6 +71,28 @@ using namespace OpenSoT::utils;
             unsigned int _number_of_bounds;
             unsigned int _aggregationPolicy;
 
+            /**
+             * @brief _is_Aineq_outdated is true when _Aineq has to be copied from the
+             * row-major piled inequality matrix before being returned by getAineq()
+             */
+            bool _is_Aineq_outdated;
+
+            /**
+             * @brief _bounds_A_generation and _bounds_A_rows are the generation and the number of
+             * rows of Aeq and Aineq of each constraint the last time Aeq and Aineq have been piled,
+             * _bounds_piled the constraints themselves, since the list can be modified by the user
+             */
+            std::vector<unsigned int> _bounds_A_generation;
+            std::vector<unsigned int> _bounds_A_rows;
+            std::vector<ConstraintType*> _bounds_piled;
+
+            /**
+             * @brief isAChanged checks whether Aeq or Aineq of some constraint changed since
+             * the last time they have been piled
+             * @return true if Aeq and Aineq have to be piled again
+             */
+            bool isAChanged();
+
             void checkSizes();
 
             static const std::string concatenateConstraintsIds(const std::list<ConstraintPtr> constraints);
@@ -137,7 +157,30 @@ using namespace OpenSoT::utils;
 
             std::list< ConstraintPtr >& getConstraintsList() { return _bounds; }
 
+            /**
+             * @brief generateAll piles the bounds and the constraints. Aeq and Aineq are piled
+             * again only if they changed in some constraint.
+             */
             void generateAll();
+
+            /**
+             * @brief getAineq returns the piled inequality matrix in column-major layout.
+             * The matrix is piled in row-major layout, and copied here only on request.
+             * Solvers should prefer getAineqRowMajor()
+             * @return the inequality matrix
+             */
+            const Eigen::MatrixXd& getAineq();
+
+            /**
+             * @brief getAineqRowMajor returns the piled inequality matrix in the row-major
+             * layout expected by qpOASES, without copies
+             * @return a block of the internal piled inequality matrix
+             */
+            Eigen::Block<const RowMajorMatrixXd> getAineqRowMajor() const { return _tmpAineq.get(); }
+
+            bool isInequalityConstraint() { return _tmpAineq.rows() > 0; }
+
+            void log(XBot::MatLogger::Ptr logger);
         };
     }
  }
@@ -45,6 +45,12 @@
             
             Eigen::VectorXd _err_lb, _err_ub;
 
+            /**
+             * @brief _task_A_generation is the generation of A of the task from which
+             * Aineq has been copied
+             */
+            unsigned int _task_A_generation;
+
         public:
 
             /**
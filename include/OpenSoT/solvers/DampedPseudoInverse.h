@@ -23,9 +23,19 @@ namespace OpenSoT{
 #endif
         /**
          * @brief _WChol is used to handle weights for each task.
-         * We compute W = LL' and then we multiply L'A and L'b
+         * We compute W = LL' and then we multiply L'A and L'b.
+         * It is computed only for a generic weight, and only when the weight changes
          */
         Eigen::LLT<Eigen::MatrixXd> _WChol;
+        /**
+         * @brief _W is the weight factorized in _WChol
+         */
+        Eigen::MatrixXd _W;
+        /**
+         * @brief _LtA and _Ltb are L'A and L'b
+         */
+        Eigen::MatrixXd _LtA;
+        Eigen::VectorXd _Ltb;
     };
     /**
      * @brief The DampedPseudoInverse class implements a eHQP solver as the one used in:
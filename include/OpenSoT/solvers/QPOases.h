@@ -34,6 +34,7 @@ namespace qpOASES {
     class Options;
     class Bounds;
     class Constraints;
+    class Arena;
 }
 
 
@@ -48,6 +49,65 @@ namespace OpenSoT{
     public:
 	typedef boost::shared_ptr<QPOases_sot> Ptr;
     typedef MatrixPiler VectorPiler;
+
+        /**
+         * @brief The LevelStats struct collects statistics about the solution of a level of the stack
+         * during the last call to solve(). Times are in seconds.
+         */
+        struct LevelStats {
+            LevelStats():
+                cost_function_time(0.), constraints_time(0.), optimality_time(0.), solve_time(0.),
+                skipped(false), screened_constraints(0), screening_resolve_counter(0),
+                promoted_constraints(0)
+            {}
+
+            void resetTimes()
+            {
+                cost_function_time = constraints_time = optimality_time = solve_time = 0.;
+            }
+
+            /**
+             * @brief cost_function_time time spent computing the cost function
+             */
+            double cost_function_time;
+            /**
+             * @brief constraints_time time spent generating the constraints (generateAll())
+             */
+            double constraints_time;
+            /**
+             * @brief optimality_time time spent stacking the optimality constraints
+             */
+            double optimality_time;
+            /**
+             * @brief solve_time time spent updating and solving the QP problem
+             */
+            double solve_time;
+            /**
+             * @brief skipped true if the level was not solved in the last solve() since the higher
+             * priority tasks already fix all the variables (tracked in nullspace mode or with
+             * compressed optimality constraints)
+             */
+            bool skipped;
+            /**
+             * @brief screened_constraints number of constraints excluded from the QP problem in the
+             * last solve(), see setConstraintScreening()
+             */
+            int screened_constraints;
+            /**
+             * @brief screening_resolve_counter number of times the QP problem has been solved again
+             * since its solution violated a screened constraint
+             */
+            unsigned int screening_resolve_counter;
+            /**
+             * @brief promoted_constraints number of constraints folded in the bounds in the last solve(),
+             * see setBoundsPromotion()
+             */
+            int promoted_constraints;
+            /**
+             * @brief problem statistics of the QP problem
+             */
+            QPOasesProblemStats problem;
+        };
         /**
          * @brief QPOases_sot constructor of the problem
          * @param stack_of_tasks a vector of tasks
@@ -124,11 +184,183 @@ namespace OpenSoT{
          */
         void activateAllStacks();
 
+        /**
+         * @brief getStats return statistics about the solution of a particular task
+         * @param i number of task
+         * @return statistics of task i
+         */
+        const LevelStats& getStats(const unsigned int i) const {return _stats[i];}
+
+        /**
+         * @brief getArena return the arena where the problems of all the levels, with their
+         * factorizations, are placed. It is sized by the constructor; problems re-created later
+         * (e.g. when the number of constraints changes) are allocated on the heap
+         * @return the arena
+         */
+        const boost::shared_ptr<qpOASES::Arena>& getArena() const {return _arena;}
+
+        /**
+         * @brief setConstraintsCapacity enables the fixed-capacity mode for the problem of a particular task:
+         * the problem is sized once for capacity constraints (constraints of the task plus optimality constraints
+         * of the previous tasks) so that a varying number of constraints does not re-create it,
+         * see QPOasesProblem::setConstraintsCapacity()
+         * @param i number of task
+         * @param capacity maximum number of constraints for task i, 0 disables the fixed-capacity mode
+         * @return true if succeed
+         */
+        bool setConstraintsCapacity(const unsigned int i, const int capacity);
+
+        /**
+         * @brief setNullSpaceMode enables/disables the nullspace mode. Instead of adding the optimality
+         * constraints of the higher priority tasks, each task is solved in the reduced variables y:
+         *      x = x* + Zy
+         * where x* is the solution of the higher priority tasks and Z is an orthonormal basis of the
+         * nullspace of their optimality constraints. The QP of the lower priority tasks shrinks instead
+         * of growing; constraints and bounds are expressed in y as general constraints.
+         * Notice that the Hessian regularisation acts on y, i.e. on the step from x*.
+         * The reduced problems of each level are kept from one solve() to the next, so the mode does
+         * not allocate memory once the ranks of the tasks settle (with a varying number of constraints,
+         * see setConstraintsCapacity()).
+         * @param flag true to enable the nullspace mode
+         * @param rank_threshold relative threshold used to compute the rank of the optimality constraints
+         */
+        void setNullSpaceMode(const bool flag, const double rank_threshold = 1e-9);
+
+        /**
+         * @brief isNullSpaceMode
+         * @return true if the nullspace mode is enabled
+         */
+        bool isNullSpaceMode() const {return _nullspace_mode;}
+
+        /**
+         * @brief setOptimalityCompression enables/disables the compression of the optimality constraints.
+         * After each task is solved, its rows and the optimality constraints of the higher priority tasks
+         * are replaced by an orthonormal basis of the space they span (computed by a rank-revealing QR):
+         *      Q'x = Q'x*
+         * where x* is the solution of the task. In this way the lower priority tasks see as many
+         * optimality constraints as independent ones, instead of all the rows of the higher priority
+         * tasks, e.g. when tasks are rank deficient or redundant with each other. When they become
+         * as many as the variables, the remaining tasks can not change the solution and are skipped.
+         * Notice that the problems are sized for all the rows, so the first solve() after enabling the
+         * compression initializes them again with fewer constraints.
+         * @param flag true to enable the compression
+         * @param rank_threshold relative threshold used to compute the rank of the optimality constraints
+         */
+        void setOptimalityCompression(const bool flag, const double rank_threshold = 1e-9);
+
+        /**
+         * @brief isOptimalityCompression
+         * @return true if the compression of the optimality constraints is enabled
+         */
+        bool isOptimalityCompression() const {return _optimality_compression;}
+
+        /**
+         * @brief setConstraintScreening enables/disables the screening of the constraints. The range of
+         * each constraint (of the task and global) over the bounds l <= x <= u, i.e. over the largest step
+         * allowed in one tick, is computed and the constraints which can not become active:
+         *      lA + margin < min(Ax) and max(Ax) < uA - margin
+         * are excluded from the QP problem. Tasks without bounds are not screened.
+         * Since the solution satisfies the bounds, it can violate a screened constraint only with a
+         * negative margin (which screens constraints that may become active): in this case the task
+         * is solved again with all the constraints.
+         * Since the number of constraints changes, the screening is meant to be used together with
+         * setConstraintsCapacity(), otherwise the problem is initialized again at every change.
+         * @param flag true to enable the screening
+         * @param margin distance from activation below which a constraint is kept
+         */
+        void setConstraintScreening(const bool flag, const double margin = 0.);
+
+        /**
+         * @brief isConstraintScreening
+         * @return true if the screening of the constraints is enabled
+         */
+        bool isConstraintScreening() const {return _constraint_screening;}
+
+        /**
+         * @brief setBoundsPromotion enables/disables the promotion of the constraints involving a single
+         * variable (of the task and global) to bounds:
+         *      lA <= a*x_j <= uA becomes lA/a <= x_j <= uA/a (swapped if a < 0)
+         * intersected with the bounds of x_j. Bounds are cheaper than constraints for qpOASES.
+         * Tasks without bounds are left untouched. As for the screening, the number of constraints
+         * changes, see setConstraintScreening()
+         * @param flag true to enable the promotion
+         */
+        void setBoundsPromotion(const bool flag);
+
+        /**
+         * @brief isBoundsPromotion
+         * @return true if the promotion of the constraints to bounds is enabled
+         */
+        bool isBoundsPromotion() const {return _bounds_promotion;}
+
+        /**
+         * @brief setDirectKKT enables/disables for all the tasks the direct solve of the KKT system with
+         * the equality constraints (e.g. the optimality constraints of the higher priority tasks) as the
+         * only active ones: qpOASES is called only if its solution violates other constraints or bounds,
+         * see QPOasesProblem::setDirectKKT()
+         * @param flag true to enable the direct solve
+         * @param tolerance used to check constraints and bounds
+         */
+        void setDirectKKT(const bool flag, const double tolerance = 1e-9);
+
     protected:
+        /**
+         * @brief _log logs the QP problems and, for each task i, the vector stats_i containing:
+         * [cost_function_time, constraints_time, optimality_time, solve_time,
+         *  hotstart_time, warmstart_time, init_time, nWSR, active_bounds, active_constraints,
+         *  nV, nC, memory, hotstart_counter, warmstart_counter, init_counter,
+         *  direct_time, direct_counter, vectors_hotstart_counter, skipped,
+         *  screened_constraints, screening_resolve_counter, promoted_constraints, closed_form_counter]
+         * @param logger a pointer to a MatLogger
+         */
         virtual void _log(XBot::MatLogger::Ptr logger);
 
+        /**
+         * @brief constraints_task constraints of the task of each level, without the global
+         * constraints and bounds
+         */
         vector <OpenSoT::constraints::Aggregated> constraints_task;
+
+        /**
+         * @brief _shared_constraints global constraints and bounds, common to all the levels:
+         * they are generated once per solve() and their rows are appended to the ones of each level
+         */
+        OpenSoT::constraints::Aggregated::Ptr _shared_constraints;
+
+        /**
+         * @brief pileLevelConstraints sets A, lA and uA to the constraints of level i followed by
+         * the global ones, and l and u to the intersection of their bounds
+         * @param i level of the stack
+         * @param reduce if true and enabled, the constraints which can not become active are piled in
+         * screened_A, screened_lA and screened_uA instead, see setConstraintScreening(), and the ones
+         * involving a single variable are folded in l and u, see setBoundsPromotion()
+         * @return number of constraints folded in l and u
+         */
+        int pileLevelConstraints(const unsigned int i, const bool reduce);
+
+        /**
+         * @brief pileConstraintRows appends the rows of lC <= Cx <= uC to A, lA and uA. If promotion,
+         * the ones involving a single variable are folded in l and u; if screening, the ones which can
+         * not become active within l and u are appended to screened_A, screened_lA and screened_uA
+         * @return number of constraints folded in l and u
+         */
+        int pileConstraintRows(const Eigen::Ref<const RowMajorMatrixXd>& C,
+                               const Eigen::VectorXd& lC, const Eigen::VectorXd& uC,
+                               const bool screening, const bool promotion);
+
+        /**
+         * @brief isScreeningViolated checks the screened constraints
+         * @param x solution of the level
+         * @param tolerance on the bounds of the solution (the boundTolerance of qpOASES)
+         * @return true if x violates one of the screened constraints by more than the tolerance
+         */
+        bool isScreeningViolated(const Eigen::VectorXd& x, const double tolerance) const;
         
+        /**
+         * @brief _arena single memory block of the problems of all the levels
+         */
+        boost::shared_ptr<qpOASES::Arena> _arena;
+
         /**
          * @brief _qp_stack_of_tasks vector of QPOases Problem
          */
@@ -147,18 +379,110 @@ namespace OpenSoT{
          */
         bool prepareSoT();
 
+        /**
+         * @brief solveNullSpace solve the stack of tasks in nullspace mode, see setNullSpaceMode()
+         * @param solution vector
+         * @return true if all the stack is solved
+         */
+        bool solveNullSpace(Eigen::VectorXd& solution);
+
+        /**
+         * @brief solveNullSpaceProblem solve the problem of the i-th task:
+         * since the number of variables changes with the rank of the higher priority tasks,
+         * the problem is initialized again when this happens
+         * @param i number of task
+         * @param H Hessian
+         * @param g gradient
+         * @param A constraints
+         * @param lA lower constraints
+         * @param uA upper constraints
+         * @param l lower bounds
+         * @param u upper bounds
+         * @return true if the problem is solved
+         */
+        bool solveNullSpaceProblem(const unsigned int i, const Eigen::MatrixXd& H, const Eigen::VectorXd& g,
+                                   const Eigen::Ref<const RowMajorMatrixXd>& A,
+                                   const Eigen::Ref<const Eigen::VectorXd>& lA,
+                                   const Eigen::Ref<const Eigen::VectorXd>& uA,
+                                   const Eigen::VectorXd& l, const Eigen::VectorXd& u);
+
+        /**
+         * @brief updateNullSpaceBasis computes the nullspace basis after the i-th task, restricting
+         * the actual one to the nullspace of the optimality constraints of the task
+         * @param i number of task
+         * @param AZ Jacobian of the solved task times the actual nullspace basis
+         * @param Z actual nullspace basis, NULL if it is the identity
+         */
+        void updateNullSpaceBasis(const unsigned int i, const Eigen::MatrixXd& AZ, const Eigen::MatrixXd* Z);
+
+        /**
+         * @brief _stats statistics about the solution of each task
+         */
+        vector<LevelStats> _stats;
+
+        /**
+         * @brief _stats_names names used to log the statistics (created once)
+         */
+        vector<std::string> _stats_names;
+
+        /**
+         * @brief The LevelHessian struct keeps the Hessian of a level, together with the
+         * generations of A and W of the task it has been computed from: it is computed again
+         * only when they change. The QP problem regularises its own copy of H, so this one is
+         * never modified by the solver
+         */
+        struct LevelHessian {
+            LevelHessian():
+                A_generation(0), W_generation(0), valid(false)
+            {}
+
+            Eigen::MatrixXd H;
+            unsigned int A_generation;
+            unsigned int W_generation;
+            bool valid;
+        };
+
+        /**
+         * @brief _hessians Hessian of each level of the stack
+         */
+        vector<LevelHessian> _hessians;
+
+        /**
+         * @brief computeLevelCostFunction computes the gradient of the cost function of level i and,
+         * if A or W of the task changed, its Hessian in _hessians[i]
+         * @param i level of the stack
+         */
+        void computeLevelCostFunction(const unsigned int i);
+
+        /**
+         * @brief _nullspace_mode true if the stack is solved in nullspace mode
+         */
+        bool _nullspace_mode;
+        double _nullspace_rank_threshold;
+
         /**
          * @brief computeCostFunction compute a cost function for velocity control:
          *          F = ||Jdq - v||
+         * H is computed by a rank update with the rows of J (scaled by the square root of the weight,
+         * if diagonal) without forming J' or WJ
          * @param task to get Jacobian and reference
          * @param H Hessian matrix computed as J'J
          * @param g reference vector computed as J'v
          */
         void computeCostFunction(const TaskPtr& task, Eigen::MatrixXd& H, Eigen::VectorXd& g);
 
+        /**
+         * @brief computeGradient compute only the reference vector of the cost function, used when
+         * the Hessian is not needed (see QPOasesProblem::isClosedForm())
+         * @param task to get Jacobian and reference
+         * @param g reference vector computed as J'v
+         */
+        void computeGradient(const TaskPtr& task, Eigen::VectorXd& g);
+
         /**
          * @brief computeOptimalityConstraint compute optimality constraint for velocity control:
          *      Jj*dqj = Jj*dqi
+         * and append it to the given pilers
          * @param task to get Jacobian of the previous task
          * @param problem to get solution of the previous task
          * @param A constraint matrix
@@ -166,24 +490,118 @@ namespace OpenSoT{
          * @param uA upper bounds
          */
         void computeOptimalityConstraint(const TaskPtr& task, QPOasesProblem& problem,
-                                         Eigen::MatrixXd& A,
-                                         Eigen::VectorXd& lA, Eigen::VectorXd& uA);
+                                         RowMajorMatrixPiler& A,
+                                         VectorPiler& lA, VectorPiler& uA);
+
+        /**
+         * @brief computeCompressedOptimalityConstraint replaces the optimality constraints with an
+         * orthonormal basis of the space spanned by them and by the Jacobian of the task just solved,
+         * see setOptimalityCompression()
+         * @param task to get Jacobian of the task just solved
+         * @param problem to get solution of the task just solved
+         */
+        void computeCompressedOptimalityConstraint(const TaskPtr& task, QPOasesProblem& problem);
+
+        /**
+         * @brief computeQColumns computes some consecutive columns of the Q factor of a QR decomposition
+         * in the first columns of tmp_Q, without allocating the whole Q
+         * @param qr QR decomposition
+         * @param first index of the first column
+         * @param cols number of columns
+         */
+        void computeQColumns(const Eigen::ColPivHouseholderQR<Eigen::MatrixXd>& qr,
+                             const int first, const int cols);
+
+        /**
+         * @brief _optimality_compression true if the optimality constraints are compressed
+         */
+        bool _optimality_compression;
+        double _optimality_rank_threshold;
+
+        /**
+         * @brief _constraint_screening true if the constraints which can not become active are screened
+         */
+        bool _constraint_screening;
+        double _screening_margin;
+
+        /**
+         * @brief _bounds_promotion true if the constraints involving a single variable are promoted to bounds
+         */
+        bool _bounds_promotion;
+
+        /**
+         * @brief screened_A, screened_lA and screened_uA constraints of the level excluded from the QP problem
+         */
+        RowMajorMatrixPiler screened_A;
+        VectorPiler screened_lA;
+        VectorPiler screened_uA;
 
 
 
         Eigen::MatrixXd H;
         Eigen::VectorXd g;
 
-        MatrixPiler A;
+        RowMajorMatrixPiler A;
         VectorPiler lA;
         VectorPiler uA;
         
         Eigen::VectorXd l;
         Eigen::VectorXd u;
         
-        std::vector<Eigen::MatrixXd> tmp_A;
-        std::vector<Eigen::VectorXd> tmp_lA;
-        std::vector<Eigen::VectorXd> tmp_uA;
+        /**
+         * @brief optimality_A, optimality_lA and optimality_uA contain the optimality constraints
+         * of the tasks solved so far: the ones of task j are computed once, right after task j is
+         * solved, and are appended. Task i uses all of them, i.e. the ones of tasks 0...i-1
+         */
+        RowMajorMatrixPiler optimality_A;
+        VectorPiler optimality_lA;
+        VectorPiler optimality_uA;
+
+        Eigen::VectorXd tmp_Ax;
+
+        /**
+         * @brief optimality_qr and tmp_optimality are used to compress the optimality constraints:
+         * the columns of tmp_optimality are their rows and the ones of the task just solved, followed
+         * by zero columns so that its size, and the buffers of optimality_qr, do not change
+         */
+        Eigen::ColPivHouseholderQR<Eigen::MatrixXd> optimality_qr;
+        Eigen::MatrixXd tmp_optimality;
+
+        /**
+         * @brief tmp_sqrtWA rows of the task matrix scaled by the square root of a diagonal weight
+         */
+        Eigen::MatrixXd tmp_sqrtWA;
+
+        /**
+         * @brief The NullSpaceLevel struct keeps the problem of a level in the reduced variables and
+         * the nullspace basis after the level. Their sizes change from level to level but not from
+         * one solve() to the next, so each level keeps its own buffers and they are not allocated again
+         */
+        struct NullSpaceLevel {
+            Eigen::MatrixXd H;
+            Eigen::VectorXd g;
+            Eigen::MatrixXd AZ;
+            Eigen::MatrixXd WAZ;
+            Eigen::VectorXd b;
+            RowMajorMatrixXd CZ;
+            Eigen::VectorXd Cx;
+            Eigen::VectorXd lA;
+            Eigen::VectorXd uA;
+            Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr;
+            Eigen::MatrixXd Z;
+        };
+
+        /**
+         * Nullspace mode: solution of the tasks solved so far, buffers of each level and temporaries
+         */
+        Eigen::VectorXd nullspace_x;
+        vector<NullSpaceLevel> _nullspace_levels;
+        Eigen::MatrixXd tmp_Q;
+        Eigen::VectorXd tmp_householder;
+        Eigen::VectorXd nullspace_l;
+        Eigen::VectorXd nullspace_u;
+
+        Eigen::VectorXd tmp_stats;
 
 
 
@@ -4,23 +4,118 @@
 #include <Eigen/Dense>
 #include <boost/shared_ptr.hpp>
 #include <OpenSoT/Task.h>
+#include <OpenSoT/utils/Piler.h>
 
 #define DEFAULT_EPS_REGULARISATION 2E2
 
 namespace qpOASES {
+    class QProblemB;
     class SQProblem;
+    class SQProblemB;
     class Options;
     class Bounds;
     class Constraints;
+    class Arena;
 }
 
 namespace OpenSoT{
     namespace solvers{
 
+    /**
+     * @brief The QPOasesProblemStats struct collects statistics about the solution of a QPOasesProblem.
+     * Times [s] are accumulated from the previous solution (e.g. an init due to a change of the number
+     * of constraints is included), nWSR and active set refer to the last solution, counters are
+     * accumulated since the creation of the problem.
+     */
+    struct QPOasesProblemStats {
+        QPOasesProblemStats():
+            hotstart_time(0.), warmstart_time(0.), init_time(0.), direct_time(0.),
+            nWSR(0), active_bounds(0), active_constraints(0),
+            nV(0), nC(0), memory(0),
+            hotstart_counter(0), warmstart_counter(0), init_counter(0), direct_counter(0),
+            vectors_hotstart_counter(0), closed_form_counter(0)
+        {}
+
+        /**
+         * @brief hotstart_time time spent in the hotstart
+         */
+        double hotstart_time;
+        /**
+         * @brief warmstart_time time spent in the fallback init using the previous solution, 0 if not used
+         */
+        double warmstart_time;
+        /**
+         * @brief init_time time spent in the (fallback) init, 0 if not used
+         */
+        double init_time;
+        /**
+         * @brief direct_time time spent in the direct solve of the KKT system (also if its solution
+         * is rejected), 0 if not used
+         */
+        double direct_time;
+        /**
+         * @brief nWSR number of working set recalculations actually used
+         */
+        int nWSR;
+        /**
+         * @brief active_bounds number of active bounds
+         */
+        int active_bounds;
+        /**
+         * @brief active_constraints number of active constraints
+         */
+        int active_constraints;
+        /**
+         * @brief nV number of variables
+         */
+        int nV;
+        /**
+         * @brief nC number of constraints (including padding rows in fixed-capacity mode)
+         */
+        int nC;
+        /**
+         * @brief memory bytes used by the data of the problem and by the dense factorizations of qpOASES
+         */
+        unsigned long memory;
+        /**
+         * @brief hotstart_counter number of problems solved with hotstart
+         */
+        unsigned int hotstart_counter;
+        /**
+         * @brief warmstart_counter number of problems solved with the fallback init using the previous solution
+         */
+        unsigned int warmstart_counter;
+        /**
+         * @brief init_counter number of problems solved with the (fallback) init
+         */
+        unsigned int init_counter;
+        /**
+         * @brief direct_counter number of problems solved with the direct solve of the KKT system
+         */
+        unsigned int direct_counter;
+        /**
+         * @brief vectors_hotstart_counter number of hotstarts in which H and A did not change since
+         * the previous call to qpOASES, so that only the vectors have been passed (and the
+         * factorizations kept)
+         */
+        unsigned int vectors_hotstart_counter;
+        /**
+         * @brief closed_form_counter number of problems solved in closed form, without qpOASES
+         */
+        unsigned int closed_form_counter;
+    };
+
     /**
      * @brief The QPOasesProblem class handle variables, options and execution of a
      * single qpOases problem. Is implemented using Eigen.
      * This represent the Back-End.
+     * A problem without constraints (only bounds) is solved by a qpOASES::SQProblemB, which skips
+     * all the work related to constraints, otherwise by a qpOASES::SQProblem: the internal problem
+     * is switched automatically when constraints appear or disappear.
+     * If moreover the Hessian is the identity, qpOASES is not called at all: the solution is the
+     * projection of -g onto the bounds (see isClosedForm()).
+     * When H and A are equal to the ones of the previous call to qpOASES, only the vectors are
+     * passed to the hotstart, which keeps the factorizations.
      */
     class QPOasesProblem {
     public:
@@ -32,17 +127,29 @@ namespace OpenSoT{
          * @param eps_regularization set the Scaling factor of identity matrix used for Hessian regularisation.
          *             final_eps_regularisation = standard_eps_regularisation * eps_regularisation
          *        this parameter is particular important for the optimization!
+         * @param arena if not null and with enough free memory (see getArenaSize()), the internal problem
+         *        and its arrays are placed in it; problems re-created later (e.g. after a change of size)
+         *        are allocated on the heap
          */
         QPOasesProblem(const int number_of_variables,
                        const int number_of_constraints,
                        OpenSoT::HessianType hessian_type = OpenSoT::HST_UNKNOWN,
-                       const double eps_regularisation = DEFAULT_EPS_REGULARISATION); //2E2
+                       const double eps_regularisation = DEFAULT_EPS_REGULARISATION, //2E2
+                       const boost::shared_ptr<qpOASES::Arena>& arena = boost::shared_ptr<qpOASES::Arena>());
 
         /**
           * @brief ~QPOasesProblem destructor
           */
         ~QPOasesProblem();
 
+        /**
+         * @brief getArenaSize
+         * @param number_of_variables of the QP problem
+         * @param number_of_constraints of the QP problem
+         * @return the number of bytes taken from an arena by an internal problem and its arrays
+         */
+        static unsigned int getArenaSize(const int number_of_variables, const int number_of_constraints);
+
         /**
          * @brief setDefaultOptions to internal qpOases problem.
          * Default are set to:
@@ -59,9 +166,23 @@ namespace OpenSoT{
 
         /**
          * @brief getProblem return the internal QP problem
-         * @return reference to internal QP problem
+         * @return reference to internal QP problem: a qpOASES::SQProblemB if isBoundsOnly(),
+         * a qpOASES::SQProblem otherwise
          */
-        const boost::shared_ptr<qpOASES::SQProblem>& getProblem(){return _problem;}
+        const boost::shared_ptr<qpOASES::QProblemB>& getProblem(){return _problem;}
+
+        /**
+         * @brief isBoundsOnly
+         * @return true if the internal problem has no constraints and is solved by a qpOASES::SQProblemB
+         */
+        bool isBoundsOnly() const {return _sq_problem_b != NULL;}
+
+        /**
+         * @brief isClosedForm
+         * @return true if the problem has only bounds and the last H passed is the identity: in this case
+         * its solution is the projection of -g onto the bounds and it is computed without qpOASES
+         */
+        bool isClosedForm() const;
 
         /**
          * @brief getOptions return the options of the QP problem
@@ -83,6 +204,8 @@ namespace OpenSoT{
          *      min = ||Hx - g||
          *  st.     lA <= Ax <= uA
          *           l <=  x <= u
+         * If the number of variables or constraints differs from the one of the internal
+         * problem, this is re-created.
          * @param H Task Matrix
          * @param g Task references
          * @param A Constraint Matrix
@@ -93,7 +216,7 @@ namespace OpenSoT{
          * @return true if the problem can be solved
          */
         bool initProblem(const Eigen::MatrixXd& H, const Eigen::VectorXd& g,
-                        const Eigen::MatrixXd& A,
+                        const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd>& A,
                         const Eigen::VectorXd& lA, const Eigen::VectorXd& uA,
                         const Eigen::VectorXd& l, const Eigen::VectorXd& u);
 
@@ -106,25 +229,37 @@ namespace OpenSoT{
          * @brief updateTask update internal H and g:
          * _H = H
          * _g = g
-         * for now is not possible to have different size of H and g wrt internal ones
+         * for now is not possible to have different size of H and g wrt internal ones.
+         * If H is equal to the internal one the factorizations of qpOASES are kept
          * @param H updated task matrix
          * @param g updated reference Eigen::VectorXd
          * @return true if task is correctly updated
          */
         bool updateTask(const Eigen::MatrixXd& H, const Eigen::VectorXd& g);
 
+        /**
+         * @brief updateTask update internal g only, H is left unchanged:
+         * _g = g
+         * useful when H is not needed, e.g. if isClosedForm()
+         * @param g updated reference Eigen::VectorXd
+         * @return true if task is correctly updated
+         */
+        bool updateTask(const Eigen::VectorXd& g);
+
         /**
          * @brief updateConstraints update internal A, lA and uA
          * _A = A
          * _lA = lA
          * _uA = uA
-         * A, lA and uA can change rows size to allow variable constraints
+         * A, lA and uA can change rows size to allow variable constraints.
+         * A is stored in the row-major layout used by qpOASES: passing a row-major
+         * matrix (e.g. from a RowMajorMatrixPiler) avoids any temporary
          * @param A update constraint matrix
          * @param lA update lower constraint Eigen::VectorXd
          * @param uA update upper constraint Eigen::VectorXd
          * @return true if constraints are correctly updated
          */
-        bool updateConstraints(const Eigen::Ref<const Eigen::MatrixXd>& A, 
+        bool updateConstraints(const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd>& A,
                                const Eigen::Ref<const Eigen::VectorXd> &lA, 
                                const Eigen::Ref<const Eigen::VectorXd> &uA);
 
@@ -150,7 +285,7 @@ namespace OpenSoT{
          * @return if the problem is correctly updated
          */
         bool updateProblem(const Eigen::MatrixXd& H, const Eigen::VectorXd& g,
-                           const Eigen::MatrixXd& A,
+                           const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd>& A,
                            const Eigen::VectorXd& lA, const Eigen::VectorXd& uA,
                            const Eigen::VectorXd& l, const Eigen::VectorXd& u);
 
@@ -190,6 +325,55 @@ namespace OpenSoT{
          */
         void setnWSR(const int nWSR){_nWSR = nWSR;}
 
+        /**
+         * @brief setConstraintsCapacity enables the fixed-capacity mode: the internal problem is sized once
+         * for capacity constraints and the rows which are not used are padded with the inert constraints
+         *      -INFTY <= 0*x <= INFTY
+         * In this way a change in the number of constraints (up to capacity) does not force the
+         * re-creation of the internal problem and the hotstart is kept. If more than capacity
+         * constraints are passed, the capacity is grown (and the internal problem re-created) once.
+         * @param capacity maximum number of constraints, 0 disables the fixed-capacity mode
+         * @return false if capacity is less than the actual number of constraints
+         */
+        bool setConstraintsCapacity(const int capacity);
+
+        /**
+         * @brief getConstraintsCapacity
+         * @return the capacity of the constraints, 0 if the fixed-capacity mode is not enabled
+         */
+        int getConstraintsCapacity() const {return _constraints_capacity;}
+
+        /**
+         * @brief setDirectKKT enables/disables the direct solve of the KKT system. Before the hotstart,
+         * the problem is solved keeping only the equality constraints (lA = uA, e.g. the optimality
+         * constraints of QPOases_sot) as active:
+         *      min 1/2x'Hx + g'x   st.   Ex = e
+         * through a LLT of H and a LDLT of the Schur complement EH^-1E'. The Hessian is regularised
+         * as done by qpOASES. If the solution satisfies all the constraints and the bounds it is
+         * optimal and qpOASES is not called, otherwise the hotstart is performed as usual.
+         * @param flag true to enable the direct solve
+         * @param tolerance used to check constraints and bounds
+         */
+        void setDirectKKT(const bool flag, const double tolerance = 1e-9);
+
+        /**
+         * @brief isDirectKKT
+         * @return true if the direct solve of the KKT system is enabled
+         */
+        bool isDirectKKT() const {return _direct_kkt;}
+
+        /**
+         * @brief getNumberOfConstraints
+         * @return the number of constraints actually used (padding rows are not counted)
+         */
+        int getNumberOfConstraints() const {return _number_of_constraints;}
+
+        /**
+         * @brief getStats return statistics about the solution of the QP problem
+         * @return statistics
+         */
+        const QPOasesProblemStats& getStats() const {return _stats;}
+
         /**
          * @brief getActiveBounds return the active bounds of the solved QP problem
          * @return active bounds
@@ -204,12 +388,14 @@ namespace OpenSoT{
 
         /**
          * Getters for internal matrices and Eigen::VectorXds
+         * (A, lA and uA do not contain the padding rows of the fixed-capacity mode)
          */
         const Eigen::MatrixXd& getH(){return _H;}
         const Eigen::VectorXd& getg(){return _g;}
-        const Eigen::MatrixXd& getA(){return _A;}
-        const Eigen::VectorXd& getlA(){return _lA;}
-        const Eigen::VectorXd& getuA(){return _uA;}
+        Eigen::Block<const OpenSoT::utils::RowMajorMatrixXd> getA() const {
+            return _A.block(0, 0, _number_of_constraints, _A.cols());}
+        Eigen::VectorBlock<const Eigen::VectorXd> getlA() const {return _lA.head(_number_of_constraints);}
+        Eigen::VectorBlock<const Eigen::VectorXd> getuA() const {return _uA.head(_number_of_constraints);}
         const Eigen::VectorXd& getl(){return _l;}
         const Eigen::VectorXd& getu(){return _u;}
 
@@ -233,12 +419,12 @@ namespace OpenSoT{
         {
             logger->add("H_"+std::to_string(i), _H);
             logger->add("g_"+std::to_string(i), _g);
-            if(_A.rows() > 0 && _A.cols() > 0)
-                logger->add("A_"+std::to_string(i), _A);
-            if(_lA.size() > 0)
-                logger->add("lA_"+std::to_string(i), _lA);
-            if(_uA.size() > 0)
-                logger->add("uA_"+std::to_string(i), _uA);
+            if(_number_of_constraints > 0 && _A.cols() > 0)
+            {
+                logger->add("A_"+std::to_string(i), getA());
+                logger->add("lA_"+std::to_string(i), getlA());
+                logger->add("uA_"+std::to_string(i), getuA());
+            }
             if(_l.size() > 0)
                 logger->add("l_"+std::to_string(i), _l);
             if(_u.size() > 0)
@@ -261,17 +447,102 @@ namespace OpenSoT{
         void checkINFTY();
 
         /**
-         * @brief _problem is the internal SQProblem
+         * @brief solveClosedForm computes the solution of a problem for which isClosedForm() holds:
+         *      x = min(max(-g, l), u)
+         * the dual solution and the active bounds are filled as qpOASES would do
+         * @return false if the bounds are inconsistent
+         */
+        bool solveClosedForm();
+
+        /**
+         * @brief solveDirectKKT solves the problem with the equality constraints only (see setDirectKKT())
+         * @return true if the solution satisfies all the constraints and bounds, in this case
+         * solution, dual solution, active bounds and constraints are updated
+         */
+        bool solveDirectKKT();
+
+        /**
+         * @brief copyConstraints copies A, lA and uA in the internal storage: in fixed-capacity mode
+         * the storage has capacity rows and the ones not used are padded with inert constraints.
+         * A is compared with the stored one to know whether it changed
+         * @return true if the number of rows of the internal storage has changed, in this case
+         * the internal problem has to be re-created
+         */
+        bool copyConstraints(const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd>& A,
+                             const Eigen::Ref<const Eigen::VectorXd>& lA,
+                             const Eigen::Ref<const Eigen::VectorXd>& uA);
+
+        /**
+         * @brief copyHessian copies _H in _H_regularised, to be passed to qpOASES
+         * @return a pointer to the data of _H_regularised
+         */
+        double* copyHessian();
+
+        /**
+         * @brief resetProblem re-creates the internal problem using the actual size of
+         * the internal storage
+         */
+        void resetProblem();
+
+        /**
+         * @brief createProblem creates the internal problem, a SQProblemB if there are no constraints and
+         * a SQProblem otherwise, in the arena if it has room for it, on the heap otherwise
          */
-        boost::shared_ptr<qpOASES::SQProblem> _problem;
+        void createProblem(const int number_of_variables,
+                           const int number_of_constraints,
+                           const OpenSoT::HessianType hessian_type);
 
         /**
-         * @brief _bounds are the active bounds of the SQProblem
+         * @brief getProblemNC
+         * @return the number of constraints of the internal problem (0 for a SQProblemB)
+         */
+        int getProblemNC() const;
+
+        /**
+         * @brief initInternalProblem initialize the internal problem using the internal data
+         * @return true if the problem can be solved
+         */
+        bool initInternalProblem();
+
+        /**
+         * @brief resetStatsTimes resets the times of the statistics if a solution has been computed
+         * since the last reset
+         */
+        void resetStatsTimes();
+
+        /**
+         * @brief updateStats updates the statistics after a successful solution
+         * @param nWSR number of working set recalculations used
+         */
+        void updateStats(const int nWSR);
+
+        /**
+         * @brief _arena provides the memory of the internal problem (may be null)
+         */
+        boost::shared_ptr<qpOASES::Arena> _arena;
+
+        /**
+         * @brief _problem is the internal problem
+         */
+        boost::shared_ptr<qpOASES::QProblemB> _problem;
+
+        /**
+         * @brief _sq_problem points to _problem if it is a SQProblem, it is null otherwise
+         */
+        qpOASES::SQProblem* _sq_problem;
+
+        /**
+         * @brief _sq_problem_b points to _problem if it is a SQProblemB, it is null otherwise
+         */
+        qpOASES::SQProblemB* _sq_problem_b;
+
+        /**
+         * @brief _bounds are the active bounds of the internal problem
          */
         boost::shared_ptr<qpOASES::Bounds> _bounds;
 
         /**
-         * @brief _constraints are the active constraints of the SQProblem
+         * @brief _constraints are the active constraints of the internal problem
          */
         boost::shared_ptr<qpOASES::Constraints> _constraints;
 
@@ -291,13 +562,57 @@ namespace OpenSoT{
         Eigen::MatrixXd _H;
         Eigen::VectorXd _g;
 
+        /**
+         * @brief _H_regularised copy of _H passed to qpOASES, which regularises it in place and
+         * keeps a pointer to its data: _H is left as given by the user
+         */
+        Eigen::MatrixXd _H_regularised;
+
+        /**
+         * @brief _is_H_changed and _is_A_changed are true if _H or _A changed since the last call to
+         * qpOASES: otherwise only the vectors are passed to the hotstart
+         */
+        bool _is_H_changed;
+        bool _is_A_changed;
+
+        /**
+         * @brief _is_initialised true if the qpOASES problem has been initialised and can be
+         * hotstarted: it is not when the problem has been solved in closed form so far
+         */
+        bool _is_initialised;
+
+        /**
+         * @brief _qpoases_H_data and _qpoases_A_data are the data of H and A qpOASES keeps a pointer
+         * to since its last call: they differ from the ones of _H_regularised and _A in a copy
+         * of the problem, which therefore has to pass the matrices again
+         */
+        const double* _qpoases_H_data;
+        const double* _qpoases_A_data;
+
         /**
          * Define a set of constraints weighted with A: lA <= Ax <= uA
+         * A is stored row-major since qpOASES does not copy it but keeps a pointer
+         * to its data: it has to be valid (and row-major) between calls to the solver
          */
-        Eigen::MatrixXd _A;
+        OpenSoT::utils::RowMajorMatrixXd _A;
         Eigen::VectorXd _lA;
         Eigen::VectorXd _uA;
 
+        /**
+         * @brief _constraints_capacity number of rows of A in fixed-capacity mode, 0 if not enabled
+         */
+        int _constraints_capacity;
+
+        /**
+         * @brief _number_of_constraints number of rows of A actually used
+         */
+        int _number_of_constraints;
+
+        /**
+         * @brief _identity_hessian true if _H is the identity (with the tolerance used by qpOASES)
+         */
+        bool _identity_hessian;
+
         /**
          * Define a set of bounds on solution: l <= x <= u
          */
@@ -310,11 +625,37 @@ namespace OpenSoT{
         Eigen::VectorXd _solution;
         Eigen::VectorXd _dual_solution;
 
+        /**
+         * @brief _stats statistics about the solution of the QP problem
+         */
+        QPOasesProblemStats _stats;
+        bool _reset_stats_times;
+
         /**
          * @brief _opt solver options
          */
         boost::shared_ptr<qpOASES::Options> _opt;
 
+        /**
+         * Direct solve of the KKT system (see setDirectKKT()): indices, matrix and right-hand side
+         * of the equality constraints, factorizations and temporaries
+         */
+        bool _direct_kkt;
+        double _direct_kkt_tolerance;
+        Eigen::VectorXi _kkt_rows;
+        Eigen::MatrixXd _kkt_E;
+        Eigen::VectorXd _kkt_e;
+        Eigen::MatrixXd _kkt_H;
+        Eigen::LLT<Eigen::MatrixXd> _kkt_llt;
+        Eigen::MatrixXd _kkt_HiEt;
+        Eigen::MatrixXd _kkt_S;
+        Eigen::LDLT<Eigen::MatrixXd> _kkt_ldlt;
+        Eigen::VectorXd _kkt_q;
+        Eigen::VectorXd _kkt_r;
+        Eigen::VectorXd _kkt_lambda;
+        Eigen::VectorXd _kkt_x;
+        Eigen::VectorXd _kkt_Ax;
+
         inline void pile(Eigen::MatrixXd& A, const Eigen::MatrixXd& B)
         {
             A.conservativeResize(A.rows()+B.rows(), A.cols());
@@ -22,6 +22,7 @@
 #include <Eigen/Dense>
 #include <boost/shared_ptr.hpp>
 #include <list>
+#include <vector>
 #include <OpenSoT/utils/Piler.h>
 
 using namespace OpenSoT::utils;
@@ -50,13 +51,29 @@ using namespace OpenSoT::utils;
             std::list< ConstraintPtr > _ownConstraints;
             std::list< ConstraintPtr > _aggregatedConstraints;
 
-            MatrixPiler _tmpA;
-            VectorPiler _tmpb;
-
             unsigned int _aggregationPolicy;
 
+            /**
+             * @brief _tasks_A_generation and _tasks_W_generation are the generations of A and W
+             * of each task the last time A has been piled
+             */
+            std::vector<unsigned int> _tasks_A_generation;
+            std::vector<unsigned int> _tasks_W_generation;
+
+            /**
+             * @brief generateAll piles \f$W_k*A_k\f$ and \f$W_k*b_k\f$ of all the tasks in A and b.
+             * The rows are written in place, without temporaries, and identity or diagonal weights
+             * are applied without a matrix product. A is piled again only if the A or the weight
+             * of some task changed.
+             */
             void generateAll();
 
+            /**
+             * @brief generateJacobianType the Aggregated of tasks with identity weight, whose A is
+             * the identity or a selection, is a selection (the identity, for a single identity task)
+             */
+            void generateJacobianType();
+
             void generateConstraints();
 
             void generateAggregatedConstraints();
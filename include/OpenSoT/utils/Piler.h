@@ -7,74 +7,105 @@
 using XBot::Logger;
 
 namespace OpenSoT { namespace utils {
-   
-    class MatrixPiler {
-        
+
+    /**
+     * @brief RowMajorMatrixXd is the storage layout qpOASES expects for the constraint matrix:
+     * matrices piled in this layout can be handed to the solver by pointer, without copies.
+     */
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMajorMatrixXd;
+
+    template <typename MatrixType>
+    class GenericPiler {
+
     public:
-        
-        MatrixPiler(const int cols = 0);
-        
+
+        GenericPiler(const int cols = 0);
+
         void reset();
         void reset(const int cols);
-        
+
         template <typename Derived>
         void pile(const Eigen::MatrixBase<Derived>& matrix);
 
         template <typename Derived>
         void set(const Eigen::MatrixBase<Derived>& matrix);
-        
-        Eigen::Block<Eigen::MatrixXd> generate_and_get();
+
+        Eigen::Block<MatrixType> generate_and_get();
+
+        /**
+         * @brief get returns the piled rows without allowing to modify them
+         */
+        Eigen::Block<const MatrixType> get() const;
+
+        /**
+         * @brief reserve allocates the memory to pile (at least) rows rows, in this way
+         * pile() does not need to expand the internal matrix while these are not exceeded
+         * @param rows number of rows to reserve
+         */
+        void reserve(const int rows);
 
         int cols() const {return _mat.cols();}
         int rows() const {return _current_row;}
 
+        /**
+         * @brief capacity
+         * @return number of rows which can be piled without expanding the internal matrix
+         */
+        int capacity() const {return _mat.rows();}
+
         double& operator[](const int i){return _mat(i);}
         double& operator()(const int i, const int j){return _mat(i,j);}
-        
+
     private:
-        
+
         int _cols;
         int _current_row;
-        
-        Eigen::MatrixXd _mat;
-        
+
+        MatrixType _mat;
+
     };
-    
+
+    typedef GenericPiler<Eigen::MatrixXd> MatrixPiler;
+    typedef GenericPiler<RowMajorMatrixXd> RowMajorMatrixPiler;
+
 } }
 
 
 
 
-inline OpenSoT::utils::MatrixPiler::MatrixPiler(const int cols):
+template <typename MatrixType>
+inline OpenSoT::utils::GenericPiler<MatrixType>::GenericPiler(const int cols):
     _cols(cols),
     _current_row(0)
 {
     _mat.resize(0, _cols);
 }
 
+template <typename MatrixType>
 template <typename Derived>
-inline void OpenSoT::utils::MatrixPiler::pile(const Eigen::MatrixBase<Derived>& matrix)
+inline void OpenSoT::utils::GenericPiler<MatrixType>::pile(const Eigen::MatrixBase<Derived>& matrix)
 {
     if(matrix.cols() != _cols){
         throw std::runtime_error("matrix.cols() != _cols");
     }
-    
+
     int rows_needed = _current_row + matrix.rows();
-    
+
     if( rows_needed > _mat.rows() ){
         Logger::info("PilerHelper: expanding to %d x %d \n", rows_needed, _cols);
         _mat.conservativeResize(rows_needed, _cols);
     }
-    
+
     _mat.block(_current_row, 0, matrix.rows(), matrix.cols()) = matrix;
-    
+
     _current_row += matrix.rows();
-    
+
 }
 
 
+template <typename MatrixType>
 template <typename Derived>
-inline void OpenSoT::utils::MatrixPiler::set(const Eigen::MatrixBase<Derived>& matrix)
+inline void OpenSoT::utils::GenericPiler<MatrixType>::set(const Eigen::MatrixBase<Derived>& matrix)
 {
     if(_cols == matrix.cols())
     {
@@ -90,12 +121,14 @@ inline void OpenSoT::utils::MatrixPiler::set(const Eigen::MatrixBase<Derived>& m
 
 }
 
-inline void OpenSoT::utils::MatrixPiler::reset()
+template <typename MatrixType>
+inline void OpenSoT::utils::GenericPiler<MatrixType>::reset()
 {
     _current_row = 0;
 }
 
-inline void OpenSoT::utils::MatrixPiler::reset(const int cols)
+template <typename MatrixType>
+inline void OpenSoT::utils::GenericPiler<MatrixType>::reset(const int cols)
 {
     if(_cols == cols)
         reset();
@@ -107,7 +140,15 @@ inline void OpenSoT::utils::MatrixPiler::reset(const int cols)
     }
 }
 
-inline Eigen::Block<Eigen::MatrixXd> OpenSoT::utils::MatrixPiler::generate_and_get()
+template <typename MatrixType>
+inline void OpenSoT::utils::GenericPiler<MatrixType>::reserve(const int rows)
+{
+    if( rows > _mat.rows() )
+        _mat.conservativeResize(rows, _cols);
+}
+
+template <typename MatrixType>
+inline Eigen::Block<MatrixType> OpenSoT::utils::GenericPiler<MatrixType>::generate_and_get()
 {
 //    if(_current_row != _mat.rows()){
 //        _mat.conservativeResize(_current_row, _cols);
@@ -116,4 +157,10 @@ inline Eigen::Block<Eigen::MatrixXd> OpenSoT::utils::MatrixPiler::generate_and_g
     return _mat.block(0,0,_current_row, _cols);
 }
 
+template <typename MatrixType>
+inline Eigen::Block<const MatrixType> OpenSoT::utils::GenericPiler<MatrixType>::get() const
+{
+    return _mat.block(0,0,_current_row, _cols);
+}
+
 #endif
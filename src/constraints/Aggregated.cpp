@@ -27,8 +27,10 @@ Aggregated::Aggregated(const std::list<ConstraintPtr> bounds,
                        const Eigen::VectorXd &q,
                        const unsigned int aggregationPolicy) :
     Constraint(concatenateConstraintsIds(bounds), q.rows()),
-               _bounds(bounds), _aggregationPolicy(aggregationPolicy)
+               _bounds(bounds), _aggregationPolicy(aggregationPolicy),
+               _is_Aineq_outdated(true)
 {
+    _tracks_generations = true;
     assert(bounds.size()>0);
     _number_of_bounds = _bounds.size();
 
@@ -41,8 +43,10 @@ Aggregated::Aggregated(const std::list<ConstraintPtr> bounds,
                        const unsigned int x_size,
                        const unsigned int aggregationPolicy) :
     Constraint(concatenateConstraintsIds(bounds), x_size),
-               _bounds(bounds), _aggregationPolicy(aggregationPolicy)
+               _bounds(bounds), _aggregationPolicy(aggregationPolicy),
+               _is_Aineq_outdated(true)
 {
+    _tracks_generations = true;
     _number_of_bounds = _bounds.size();
     this->checkSizes();
     /* calling update to generate bounds */
@@ -54,8 +58,10 @@ Aggregated::Aggregated(ConstraintPtr bound1,
                        const unsigned int &x_size,
                        const unsigned int aggregationPolicy) :
     Constraint(bound1->getConstraintID() + "plus" + bound2->getConstraintID(),
-               x_size), _aggregationPolicy(aggregationPolicy)
+               x_size), _aggregationPolicy(aggregationPolicy),
+               _is_Aineq_outdated(true)
 {
+    _tracks_generations = true;
     _bounds.push_back(bound1);
     _bounds.push_back(bound2);
 
@@ -79,58 +85,89 @@ void Aggregated::update(const Eigen::VectorXd& x) {
     this->generateAll();
 }
 
+bool Aggregated::isAChanged()
+{
+    bool is_A_changed = false;
+    if(_bounds_A_generation.size() != _bounds.size())
+    {
+        _bounds_A_generation.resize(_bounds.size());
+        _bounds_A_rows.assign(_bounds.size(), 0);
+        _bounds_piled.assign(_bounds.size(), NULL);
+        is_A_changed = true;
+    }
+
+    unsigned int k = 0;
+    for(typename std::list< ConstraintPtr >::iterator i = _bounds.begin();
+        i != _bounds.end(); ++i, ++k) {
+        ConstraintPtr &b = *i;
+        const unsigned int rows = b->getAeq().rows() + b->getAineq().rows();
+
+        /* a constraint which does not track its generations may change at every update,
+           unless it is a bound */
+        if(b.get() != _bounds_piled[k] || rows != _bounds_A_rows[k] ||
+           (rows > 0 && (!b->tracksGenerations() ||
+                         b->getAGeneration() != _bounds_A_generation[k])))
+            is_A_changed = true;
+
+        _bounds_A_rows[k] = rows;
+        _bounds_piled[k] = b.get();
+        _bounds_A_generation[k] = b->getAGeneration();
+    }
+    return is_A_changed;
+}
+
 void Aggregated::generateAll() {
+    if(_constraint_id.empty() || _number_of_bounds != _bounds.size()){
+        _number_of_bounds = _bounds.size();
+        _constraint_id = concatenateConstraintsIds(getConstraintsList());}
+
+    /* an empty list never changes, but its matrices have to be sized at least once */
+    const bool pile_A = this->isAChanged() || _tmpAineq.cols() != _x_size;
+
     /* resetting all internal data */
-    _tmpupperBound.reset(1);
-    _tmplowerBound.reset(1);
+    bool has_bounds = false;
 
-    _tmpAeq.reset(_x_size);
+    if(pile_A)
+        _tmpAeq.reset(_x_size);
     _tmpbeq.reset(1);
 
-    _tmpAineq.reset(_x_size);
+    if(pile_A)
+        _tmpAineq.reset(_x_size);
     _tmpbUpperBound.reset(1);
     _tmpbLowerBound.reset(1);
 
-    if(_constraint_id.empty() || _number_of_bounds != _bounds.size()){
-        _number_of_bounds = _bounds.size();
-        _constraint_id = concatenateConstraintsIds(getConstraintsList());}
-
     /* iterating on all bounds.. */
     for(typename std::list< ConstraintPtr >::iterator i = _bounds.begin();
         i != _bounds.end(); i++) {
 
         ConstraintPtr &b = *i;
 
-        Eigen::VectorXd boundUpperBound = b->getUpperBound();
-        Eigen::VectorXd boundLowerBound = b->getLowerBound();
+        /* children are read through references: nothing is copied before piling */
+        const Eigen::VectorXd& boundUpperBound = b->getUpperBound();
+        const Eigen::VectorXd& boundLowerBound = b->getLowerBound();
 
-        Eigen::MatrixXd boundAeq = b->getAeq();
-        Eigen::VectorXd boundbeq = b->getbeq();
+        const Eigen::MatrixXd& boundAeq = b->getAeq();
+        const Eigen::VectorXd& boundbeq = b->getbeq();
 
-        Eigen::MatrixXd boundAineq = b->getAineq();
-        Eigen::VectorXd boundbUpperBound = b->getbUpperBound();
-        Eigen::VectorXd boundbLowerBound = b->getbLowerBound();
+        const Eigen::MatrixXd& boundAineq = b->getAineq();
+        const Eigen::VectorXd& boundbUpperBound = b->getbUpperBound();
+        const Eigen::VectorXd& boundbLowerBound = b->getbLowerBound();
 
-        /* copying lowerBound, upperBound */
+        /* merging lowerBound, upperBound straight into the output vectors,
+           which keep their size (and memory) from one update to the next */
         if(boundUpperBound.rows() != 0 ||
            boundLowerBound.rows() != 0) {
             assert(boundUpperBound.rows() == _x_size);
             assert(boundLowerBound.rows() == _x_size);
 
-            if(_tmpupperBound.rows() == 0 ||
-               _tmplowerBound.rows() == 0) { // first valid bounds found
-                assert(_tmpupperBound.rows() == _tmplowerBound.rows());
-                _tmpupperBound.set(boundUpperBound);
-                _tmplowerBound.set(boundLowerBound);
+            if(!has_bounds) { // first valid bounds found
+                _upperBound = boundUpperBound;
+                _lowerBound = boundLowerBound;
+                has_bounds = true;
             } else {
-                for(unsigned int i = 0; i < _x_size; ++i) {
-                    // compute the minimum between current and new upper bounds
-                    _tmpupperBound[i] = std::min(  _tmpupperBound[i],
-                                                boundUpperBound[i]);
-                    // compute the maximum between current and new lower bounds
-                    _tmplowerBound[i] = std::max(  _tmplowerBound[i],
-                                                boundLowerBound[i]);
-                }
+                // minimum between current and new upper bounds, maximum between lower bounds
+                _upperBound = _upperBound.cwiseMin(boundUpperBound);
+                _lowerBound = _lowerBound.cwiseMax(boundLowerBound);
             }
         }
 
@@ -143,7 +180,8 @@ void Aggregated::generateAll() {
                 beq <= Aeq*x <= beq */
             if(_aggregationPolicy & EQUALITIES_TO_INEQUALITIES) {
                 assert(_tmpAineq.cols() == boundAeq.cols());
-                _tmpAineq.pile(boundAeq);
+                if(pile_A)
+                    _tmpAineq.pile(boundAeq);
                 _tmpbUpperBound.pile(boundbeq);
                 if(_aggregationPolicy & UNILATERAL_TO_BILATERAL) {
                     _tmpbLowerBound.pile(boundbeq);
@@ -152,12 +190,14 @@ void Aggregated::generateAll() {
                    -Aeq*x <= -beq && Aeq*x <= beq */
                 } else {
                     assert(_tmpAineq.cols() == boundAeq.cols());
-                    _tmpAineq.pile(-1.0*boundAeq);
+                    if(pile_A)
+                        _tmpAineq.pile(-1.0*boundAeq);
                     _tmpbUpperBound.pile( -1.0 * boundbeq);
                 }
             } else {
                 assert(_tmpAeq.cols() == boundAeq.cols());
-                _tmpAeq.pile(boundAeq);
+                if(pile_A)
+                    _tmpAeq.pile(boundAeq);
                 _tmpbeq.pile(boundbeq);
             }
         }
@@ -174,72 +214,94 @@ void Aggregated::generateAll() {
 
             /* if we need to transform all unilateral bounds to bilateral.. */
             if(_aggregationPolicy & UNILATERAL_TO_BILATERAL) {
+                if(pile_A)
+                    _tmpAineq.pile(boundAineq);
                 if(boundbUpperBound.rows() == 0) {
                     assert(boundAineq.rows() == boundbLowerBound.rows());
-                    boundbUpperBound.resize(boundAineq.rows());
-                    boundbUpperBound<<boundbUpperBound.setOnes(boundAineq.rows())*std::numeric_limits<double>::infinity();
+                    _tmpbUpperBound.pile(Eigen::VectorXd::Constant(boundAineq.rows(),
+                                            std::numeric_limits<double>::infinity()));
+                    _tmpbLowerBound.pile(boundbLowerBound);
                 } else if(boundbLowerBound.rows() == 0) {
                     assert(boundAineq.rows() == boundbUpperBound.rows());
-                    boundbLowerBound.resize(boundAineq.rows());
-                    boundbLowerBound<<boundbLowerBound.setOnes(boundAineq.rows())*-std::numeric_limits<double>::max();
+                    _tmpbUpperBound.pile(boundbUpperBound);
+                    _tmpbLowerBound.pile(Eigen::VectorXd::Constant(boundAineq.rows(),
+                                            -std::numeric_limits<double>::max()));
                 } else {
                     assert(boundAineq.rows() == boundbLowerBound.rows());
                     assert(boundAineq.rows() == boundbUpperBound.rows());
+                    _tmpbUpperBound.pile(boundbUpperBound);
+                    _tmpbLowerBound.pile(boundbLowerBound);
                 }
             /* if we need to transform all bilateral bounds to unilateral.. */
             } else {
                 /* we need to transform l < Ax into -Ax < -l */
                 if(boundbUpperBound.rows() == 0) {
-                    boundAineq = -1.0 * boundAineq;
-                    boundbLowerBound = -1.0 * boundbLowerBound;
                     assert(boundAineq.rows() == boundbLowerBound.rows());
+                    if(pile_A)
+                        _tmpAineq.pile(-1.0 * boundAineq);
+                    _tmpbUpperBound.pile(-1.0 * boundbLowerBound);
                 } else if(boundbLowerBound.rows() == 0) {
                     assert(boundAineq.rows() == boundbUpperBound.rows());
+                    if(pile_A)
+                        _tmpAineq.pile(boundAineq);
+                    _tmpbUpperBound.pile(boundbUpperBound);
                 } else {
                     assert(boundAineq.rows() == boundbLowerBound.rows());
                     assert(boundAineq.rows() == boundbUpperBound.rows());
-                    pile(boundAineq,-1.0 * boundAineq);
-                    pile(boundbUpperBound,-1.0 * boundbLowerBound);
+                    if(pile_A) {
+                        _tmpAineq.pile(boundAineq);
+                        _tmpAineq.pile(-1.0 * boundAineq);
+                    }
+                    _tmpbUpperBound.pile(boundbUpperBound);
+                    _tmpbUpperBound.pile(-1.0 * boundbLowerBound);
                 }
             }
-
-            assert(_tmpAineq.cols() == boundAineq.cols());
-            _tmpAineq.pile(boundAineq);
-            _tmpbUpperBound.pile(boundbUpperBound);
-            /*  if using UNILATERAL_TO_BILATERAL we always have lower bounds,
-                otherwise, we never have them */
-            if(_aggregationPolicy & UNILATERAL_TO_BILATERAL)
-                _tmpbLowerBound.pile( boundbLowerBound);
         }
     }
 
+    if(!has_bounds) {
+        _upperBound.resize(0);
+        _lowerBound.resize(0);
+    }
+
     /* checking everything went fine */
-    assert(_tmplowerBound.rows() == 0 || _tmplowerBound.rows() == _x_size);
-    assert(_tmpupperBound.rows() == 0 || _tmpupperBound.rows() == _x_size);
+    assert(_lowerBound.rows() == 0 || _lowerBound.rows() == _x_size);
+    assert(_upperBound.rows() == 0 || _upperBound.rows() == _x_size);
 
     assert(_tmpAeq.rows() == _tmpbeq.rows());
     if(_tmpAeq.rows() > 0)
         assert(_tmpAeq.cols() == _x_size);
 
     assert(_tmpAineq.rows() == _tmpbUpperBound.rows());
-    if(!(_aggregationPolicy & UNILATERAL_TO_BILATERAL))
+    if(_aggregationPolicy & UNILATERAL_TO_BILATERAL)
         assert(_tmpAineq.rows() == _tmpbLowerBound.rows());
     if(_tmpAineq.rows() > 0)
         assert(_tmpAineq.cols() == _x_size);
 
 
-    _upperBound = _tmpupperBound.generate_and_get();
-    _lowerBound = _tmplowerBound.generate_and_get();
-
-    _Aeq = _tmpAeq.generate_and_get();
     _beq = _tmpbeq.generate_and_get();
 
-    _Aineq = _tmpAineq.generate_and_get();
+    if(pile_A)
+    {
+        _Aeq = _tmpAeq.generate_and_get();
+        _is_Aineq_outdated = true;
+        ++_A_generation;
+    }
     _bUpperBound = _tmpbUpperBound.generate_and_get();
     _bLowerBound = _tmpbLowerBound.generate_and_get();
 
 }
 
+const Eigen::MatrixXd& Aggregated::getAineq()
+{
+    if(_is_Aineq_outdated)
+    {
+        _Aineq = _tmpAineq.get();
+        _is_Aineq_outdated = false;
+    }
+    return _Aineq;
+}
+
 void Aggregated::checkSizes()
 {
     for(std::list< ConstraintPtr >::iterator i = _bounds.begin();
@@ -260,6 +322,13 @@ const std::string Aggregated::concatenateConstraintsIds(const std::list<Constrai
     return concatenatedId;
 }
 
+void Aggregated::log(XBot::MatLogger::Ptr logger)
+{
+    // making sure _Aineq is up to date before logging it
+    getAineq();
+    Constraint::log(logger);
+}
+
 void Aggregated::_log(XBot::MatLogger::Ptr logger)
 {
     for(auto bound : _bounds)
@@ -37,6 +37,9 @@ BilateralConstraint::BilateralConstraint(const Eigen::MatrixXd &Aineq,
     _bLowerBound = bLowerBound;
     _bUpperBound = bUpperBound;
 
+    // Aineq is never changed after construction
+    _tracks_generations = true;
+
     assert( (_Aineq.rows() == _bLowerBound.size()) &&
             (_Aineq.rows() == _bUpperBound.size()));
 }
@@ -52,6 +55,9 @@ BilateralConstraint::BilateralConstraint(const std::string constraintName,
     _bLowerBound = bLowerBound;
     _bUpperBound = bUpperBound;
 
+    // Aineq is never changed after construction
+    _tracks_generations = true;
+
     assert( (_Aineq.rows() == _bLowerBound.rows()) &&
             (_Aineq.rows() == _bUpperBound.rows()));
 }
@@ -26,7 +26,8 @@ TaskToConstraint::TaskToConstraint(TaskPtr task) :
     BilateralConstraint(task->getTaskID(), task->getA(), task->getb(), task->getb()),
     _task(task),
     _err_lb(Eigen::VectorXd::Zero(task->getTaskSize())),
-    _err_ub(Eigen::VectorXd::Zero(task->getTaskSize()))
+    _err_ub(Eigen::VectorXd::Zero(task->getTaskSize())),
+    _task_A_generation(task->getAGeneration())
 {
     this->generateAll();
 }
@@ -37,7 +38,8 @@ TaskToConstraint::TaskToConstraint(TaskToConstraint::TaskPtr task,
     BilateralConstraint(task->getTaskID(), task->getA(), task->getb() + err_lb, task->getb() + err_ub),
     _task(task),
     _err_lb(err_lb),
-    _err_ub(err_ub)
+    _err_ub(err_ub),
+    _task_A_generation(task->getAGeneration())
 {
     
     if( ((err_ub-err_lb).array() < 0).any() ){
@@ -62,7 +64,13 @@ void TaskToConstraint::update(const Eigen::VectorXd &q)
 
 void TaskToConstraint::generateAll() {
     
-    _Aineq = _task->getA();
+    // Aineq is copied again only if A changed in the task
+    if(_task->getAGeneration() != _task_A_generation)
+    {
+        _Aineq = _task->getA();
+        _task_A_generation = _task->getAGeneration();
+        ++_A_generation;
+    }
     _bLowerBound = _task->getb() + _err_lb;
     _bUpperBound = _task->getb() + _err_ub;
     
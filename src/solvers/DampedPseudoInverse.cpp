@@ -63,9 +63,33 @@ bool DampedPseudoInverse::solve(Eigen::VectorXd& solution)
     solution.setZero(solution.size());
     for(unsigned int i = 1; i <= _tasks.size(); ++i)
     {
-        _stack_levels[i]._WChol.compute(_tasks[i-1]->getWeight());
+        const Eigen::MatrixXd& W = _tasks[i-1]->getWeight();
+        const OpenSoT::WeightType weight_type = _tasks[i-1]->getWeightType();
+        switch(weight_type)
+        {
+        case OpenSoT::WT_IDENTITY:
+            _stack_levels[i]._LtA = _tasks[i-1]->getA();
+            _stack_levels[i]._Ltb = _tasks[i-1]->getb();
+            break;
+        case OpenSoT::WT_DIAGONAL:
+            _stack_levels[i]._LtA.noalias() = W.diagonal().cwiseSqrt().asDiagonal() * _tasks[i-1]->getA();
+            _stack_levels[i]._Ltb.noalias() = W.diagonal().cwiseSqrt().asDiagonal() * _tasks[i-1]->getb();
+            break;
+        default:
+            if(_stack_levels[i]._W.rows() != W.rows() || _stack_levels[i]._W != W)
+            {
+                _stack_levels[i]._W = W;
+                _stack_levels[i]._WChol.compute(W);
+            }
+            _stack_levels[i]._LtA.noalias() = _stack_levels[i]._WChol.matrixL().transpose() * _tasks[i-1]->getA();
+            _stack_levels[i]._Ltb.noalias() = _stack_levels[i]._WChol.matrixL().transpose() * _tasks[i-1]->getb();
+        }
 
-        _stack_levels[i]._JP = _stack_levels[i]._WChol.matrixL().transpose() * _tasks[i-1]->getA()*_stack_levels[i-1]._P;
+        // with an identity A and weight, or a diagonal weight, L'A is diagonal: the rows of P are only scaled
+        if(_tasks[i-1]->getJacobianType() == OpenSoT::JT_IDENTITY && weight_type != OpenSoT::WT_DENSE)
+            _stack_levels[i]._JP.noalias() = _stack_levels[i]._LtA.diagonal().asDiagonal()*_stack_levels[i-1]._P;
+        else
+            _stack_levels[i]._JP = _stack_levels[i]._LtA*_stack_levels[i-1]._P;
         _stack_levels[i]._JPsvd.compute(_stack_levels[i]._JP);
 
 #if EIGEN_MINOR_VERSION <= 0
@@ -79,8 +103,7 @@ bool DampedPseudoInverse::solve(Eigen::VectorXd& solution)
 #endif
 
          solution += _stack_levels[i]._JPpinv * (
-                     _stack_levels[i]._WChol.matrixL().transpose() * _tasks[i-1]->getb()-
-                 _stack_levels[i]._WChol.matrixL().transpose() * _tasks[i-1]->getA()*solution
+                     _stack_levels[i]._Ltb - _stack_levels[i]._LtA*solution
                  );
 
 
@@ -2,6 +2,7 @@
 #include <OpenSoT/solvers/QPOases.h>
 #include <OpenSoT/constraints/BilateralConstraint.h>
 #include <XBotInterface/Logger.hpp>
+#include <chrono>
 
 #define GREEN "\033[0;32m"
 #define YELLOW "\033[0;33m"
@@ -10,9 +11,23 @@
 
 using namespace OpenSoT::solvers;
 
+typedef std::chrono::steady_clock Clock;
+
+static inline double elapsed(const Clock::time_point& start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
 QPOases_sot::QPOases_sot(Stack &stack_of_tasks, const double eps_regularisation):
     Solver(stack_of_tasks),
-    _epsRegularisation(eps_regularisation)
+    _epsRegularisation(eps_regularisation),
+    _nullspace_mode(false),
+    _nullspace_rank_threshold(1e-9),
+    _optimality_compression(false),
+    _optimality_rank_threshold(1e-9),
+    _constraint_screening(false),
+    _screening_margin(0.),
+    _bounds_promotion(false)
 {
     for(unsigned int i = 0; i < stack_of_tasks.size(); ++i)
         _active_stacks.push_back(true);
@@ -25,7 +40,14 @@ QPOases_sot::QPOases_sot(Stack &stack_of_tasks,
                          ConstraintPtr bounds,
                          const double eps_regularisation):
     Solver(stack_of_tasks, bounds),
-    _epsRegularisation(eps_regularisation)
+    _epsRegularisation(eps_regularisation),
+    _nullspace_mode(false),
+    _nullspace_rank_threshold(1e-9),
+    _optimality_compression(false),
+    _optimality_rank_threshold(1e-9),
+    _constraint_screening(false),
+    _screening_margin(0.),
+    _bounds_promotion(false)
 {
     for(unsigned int i = 0; i < stack_of_tasks.size(); ++i)
         _active_stacks.push_back(true);
@@ -39,7 +61,14 @@ QPOases_sot::QPOases_sot(Stack &stack_of_tasks,
                          ConstraintPtr globalConstraints,
                          const double eps_regularisation):
     Solver(stack_of_tasks, bounds, globalConstraints),
-    _epsRegularisation(eps_regularisation)
+    _epsRegularisation(eps_regularisation),
+    _nullspace_mode(false),
+    _nullspace_rank_threshold(1e-9),
+    _optimality_compression(false),
+    _optimality_rank_threshold(1e-9),
+    _constraint_screening(false),
+    _screening_margin(0.),
+    _bounds_promotion(false)
 {
     for(unsigned int i = 0; i < stack_of_tasks.size(); ++i)
         _active_stacks.push_back(true);
@@ -53,86 +82,407 @@ void QPOases_sot::computeCostFunction(const TaskPtr& task, Eigen::MatrixXd& H, E
 //    H = task->getA().transpose() * task->getWeight() * task->getA();
 //    g = -1.0 * task->getA().transpose() * task->getWeight() * task->getb();
 
+    const Eigen::MatrixXd& A = task->getA();
+    const Eigen::MatrixXd& W = task->getWeight();
+    const OpenSoT::WeightType weight_type = task->getWeightType();
 
     H.resize(task->getXSize(), task->getXSize());
-    if(task->getWeight().isIdentity())
+
+    // with an identity or selection A no product is needed: H = W, or W scattered in the selected rows and columns
+    if(task->getJacobianType() == OpenSoT::JT_IDENTITY)
+    {
+        if(weight_type == OpenSoT::WT_IDENTITY)
+            H.setIdentity();
+        else if(weight_type == OpenSoT::WT_DIAGONAL)
+        {
+            H.setZero();
+            H.diagonal() = W.diagonal();
+        }
+        else
+            H = W;
+        computeGradient(task, g);
+        return;
+    }
+    if(task->getJacobianType() == OpenSoT::JT_SELECTION)
+    {
+        const std::vector<unsigned int>& selection = task->getJacobianSelection();
+        H.setZero();
+        if(weight_type == OpenSoT::WT_DENSE)
+        {
+            for(unsigned int r = 0; r < selection.size(); ++r)
+                for(unsigned int c = 0; c < selection.size(); ++c)
+                    H(selection[r], selection[c]) += W(r,c);
+        }
+        else
+        {
+            for(unsigned int r = 0; r < selection.size(); ++r)
+                H(selection[r], selection[r]) += W(r,r);
+        }
+        computeGradient(task, g);
+        return;
+    }
+
+    // only the upper part of H is computed, by a rank update (SYRK) with the rows of sqrt(W)A:
+    // neither A' nor WA are formed unless W is a full matrix
+    H.triangularView<Eigen::Upper>().setZero();
+    if(weight_type == OpenSoT::WT_IDENTITY)
+        H.selfadjointView<Eigen::Upper>().rankUpdate(A.transpose());
+    else if(weight_type == OpenSoT::WT_DIAGONAL && (W.diagonal().array() >= 0.).all())
     {
-        H.triangularView<Eigen::Upper>() = task->getATranspose()*task->getA();
-        H = H.selfadjointView<Eigen::Upper>();
-        g.noalias() = -1.0 * task->getATranspose() * task->getb();
+        tmp_sqrtWA.noalias() = W.diagonal().cwiseSqrt().asDiagonal()*A;
+        H.selfadjointView<Eigen::Upper>().rankUpdate(tmp_sqrtWA.transpose());
     }
     else
+        H.triangularView<Eigen::Upper>() = A.transpose()*task->getWA();
+    H = H.selfadjointView<Eigen::Upper>();
+    computeGradient(task, g);
+}
+
+void QPOases_sot::computeLevelCostFunction(const unsigned int i)
+{
+    const TaskPtr& task = _tasks[i];
+    LevelHessian& hessian = _hessians[i];
+    if(hessian.valid &&
+       hessian.A_generation == task->getAGeneration() &&
+       hessian.W_generation == task->getWeightGeneration())
     {
-        H.triangularView<Eigen::Upper>() = task->getATranspose()*task->getWA();
-        H = H.selfadjointView<Eigen::Upper>();
-        g.noalias() = -1.0 * task->getATranspose() * task->getWb();
+        computeGradient(task, g);
+        return;
     }
+
+    computeCostFunction(task, hessian.H, g);
+    hessian.A_generation = task->getAGeneration();
+    hessian.W_generation = task->getWeightGeneration();
+    hessian.valid = true;
+}
+
+void QPOases_sot::computeGradient(const TaskPtr& task, Eigen::VectorXd& g)
+{
+    if(task->getJacobianType() == OpenSoT::JT_IDENTITY)
+    {
+        g = -task->getWb();
+        return;
+    }
+    if(task->getJacobianType() == OpenSoT::JT_SELECTION)
+    {
+        const std::vector<unsigned int>& selection = task->getJacobianSelection();
+        const Eigen::VectorXd& Wb = task->getWb();
+        g.setZero(task->getXSize());
+        for(unsigned int r = 0; r < selection.size(); ++r)
+            g[selection[r]] -= Wb[r];
+        return;
+    }
+
+    if(task->getWeightType() == OpenSoT::WT_IDENTITY)
+        g.noalias() = -1.0 * task->getA().transpose() * task->getb();
+    else
+        g.noalias() = -1.0 * task->getA().transpose() * task->getWb();
 }
 
 void QPOases_sot::computeOptimalityConstraint(  const TaskPtr& task, QPOasesProblem& problem,
-                                                Eigen::MatrixXd& A, Eigen::VectorXd& lA, Eigen::VectorXd& uA)
+                                                RowMajorMatrixPiler& A, VectorPiler& lA, VectorPiler& uA)
+{
+    const int rows = task->getA().rows();
+    if(tmp_Ax.size() < rows)
+        tmp_Ax.resize(rows);
+    if(task->getJacobianType() == OpenSoT::JT_IDENTITY)
+        tmp_Ax.head(rows) = problem.getSolution();
+    else if(task->getJacobianType() == OpenSoT::JT_SELECTION)
+    {
+        const std::vector<unsigned int>& selection = task->getJacobianSelection();
+        for(int r = 0; r < rows; ++r)
+            tmp_Ax[r] = problem.getSolution()[selection[r]];
+    }
+    else
+        tmp_Ax.head(rows).noalias() = task->getA()*problem.getSolution();
+    A.pile(task->getA());
+    lA.pile(tmp_Ax.head(rows));
+    uA.pile(tmp_Ax.head(rows));
+}
+
+void QPOases_sot::computeCompressedOptimalityConstraint(const TaskPtr& task, QPOasesProblem& problem)
+{
+    const int n = task->getXSize();
+    const int previous_rows = optimality_A.rows();
+    const int rows = task->getA().rows();
+    if(tmp_optimality.rows() != n || tmp_optimality.cols() < previous_rows + rows)
+        tmp_optimality.resize(n, previous_rows + rows);
+    tmp_optimality.leftCols(previous_rows) = optimality_A.get().transpose();
+    tmp_optimality.middleCols(previous_rows, rows) = task->getA().transpose();
+    tmp_optimality.rightCols(tmp_optimality.cols() - previous_rows - rows).setZero();
+
+    // the first rank columns of Q are an orthonormal basis of the space spanned by the rows
+    optimality_qr.setThreshold(_optimality_rank_threshold);
+    optimality_qr.compute(tmp_optimality);
+    const int rank = optimality_qr.rank();
+    computeQColumns(optimality_qr, 0, rank);
+
+    if(tmp_Ax.size() < rank)
+        tmp_Ax.resize(rank);
+    tmp_Ax.head(rank).noalias() = tmp_Q.topLeftCorner(n, rank).transpose()*problem.getSolution();
+    optimality_A.set(tmp_Q.topLeftCorner(n, rank).transpose());
+    optimality_lA.set(tmp_Ax.head(rank));
+    optimality_uA.set(tmp_Ax.head(rank));
+}
+
+void QPOases_sot::computeQColumns(const Eigen::ColPivHouseholderQR<Eigen::MatrixXd>& qr,
+                                  const int first, const int cols)
+{
+    const int n = qr.rows();
+    if(tmp_Q.rows() < n || tmp_Q.cols() < cols)
+        tmp_Q.resize(n, n);
+    if(tmp_householder.size() < cols)
+        tmp_householder.resize(n);
+
+    // Q = H_0*...*H_k is applied to the columns of the identity: the reflections after the last
+    // column do not change them
+    Eigen::Block<Eigen::MatrixXd> Q = tmp_Q.topLeftCorner(n, cols);
+    Q.setZero();
+    Q.middleRows(first, cols).setIdentity();
+    const int reflections = std::min<int>(qr.hCoeffs().size(), first + cols);
+    for(int k = reflections - 1; k >= 0; --k)
+        Q.bottomRows(n - k).applyHouseholderOnTheLeft(qr.matrixQR().col(k).tail(n - k - 1),
+                                                      qr.hCoeffs()[k], tmp_householder.data());
+}
+
+int QPOases_sot::pileLevelConstraints(const unsigned int i, const bool reduce)
+{
+    OpenSoT::constraints::Aggregated& constraints_task_i = constraints_task[i];
+
+    const Eigen::VectorXd& level_l = constraints_task_i.getLowerBound();
+    const Eigen::VectorXd& level_u = constraints_task_i.getUpperBound();
+    const Eigen::VectorXd& shared_l = _shared_constraints->getLowerBound();
+    const Eigen::VectorXd& shared_u = _shared_constraints->getUpperBound();
+    if(level_l.size() == 0)
+    {
+        l = shared_l;
+        u = shared_u;
+    }
+    else if(shared_l.size() == 0)
+    {
+        l = level_l;
+        u = level_u;
+    }
+    else
+    {
+        l = level_l.cwiseMax(shared_l);
+        u = level_u.cwiseMin(shared_u);
+    }
+
+    A.reset(_tasks[i]->getXSize());
+    lA.reset(1);
+    uA.reset(1);
+    screened_A.reset(_tasks[i]->getXSize());
+    screened_lA.reset(1);
+    screened_uA.reset(1);
+
+    // the rows of the level are followed by the ones of the global constraints, generated once for all the levels
+    const bool screening = reduce && _constraint_screening && l.size() > 0;
+    const bool promotion = reduce && _bounds_promotion && l.size() > 0;
+    return pileConstraintRows(constraints_task_i.getAineqRowMajor(),
+                              constraints_task_i.getbLowerBound(), constraints_task_i.getbUpperBound(),
+                              screening, promotion) +
+           pileConstraintRows(_shared_constraints->getAineqRowMajor(),
+                              _shared_constraints->getbLowerBound(), _shared_constraints->getbUpperBound(),
+                              screening, promotion);
+}
+
+int QPOases_sot::pileConstraintRows(const Eigen::Ref<const RowMajorMatrixXd>& C,
+                                    const Eigen::VectorXd& lC, const Eigen::VectorXd& uC,
+                                    const bool screening, const bool promotion)
 {
-    A = task->getA();
-    lA = task->getA()*problem.getSolution();
-    uA = lA;
+    if(!screening && !promotion)
+    {
+        A.pile(C);
+        lA.pile(lC);
+        uA.pile(uC);
+        return 0;
+    }
+
+    int promoted = 0;
+    for(int r = 0; r < C.rows(); ++r)
+    {
+        if(promotion)
+        {
+            int column = -1;
+            int nonzeros = 0;
+            for(int c = 0; c < C.cols() && nonzeros < 2; ++c)
+            {
+                if(C(r,c) != 0.)
+                {
+                    column = c;
+                    ++nonzeros;
+                }
+            }
+
+            // lC <= a*x_j <= uC is folded in the bounds of x_j
+            if(nonzeros == 1)
+            {
+                const double a = C(r,column);
+                l[column] = std::max(l[column], a > 0. ? lC[r]/a : uC[r]/a);
+                u[column] = std::min(u[column], a > 0. ? uC[r]/a : lC[r]/a);
+                ++promoted;
+                continue;
+            }
+        }
+
+        if(!screening)
+        {
+            A.pile(C.row(r));
+            lA.pile(lC.segment(r,1));
+            uA.pile(uC.segment(r,1));
+            continue;
+        }
+
+        // range of C.row(r)*x for l <= x <= u (NaN, and then not screened, with infinite bounds)
+        const double row_min = (C.row(r).array().max(0.)*l.transpose().array() +
+                                C.row(r).array().min(0.)*u.transpose().array()).sum();
+        const double row_max = (C.row(r).array().max(0.)*u.transpose().array() +
+                                C.row(r).array().min(0.)*l.transpose().array()).sum();
+
+        if(row_min > lC[r] + _screening_margin && row_max < uC[r] - _screening_margin)
+        {
+            screened_A.pile(C.row(r));
+            screened_lA.pile(lC.segment(r,1));
+            screened_uA.pile(uC.segment(r,1));
+        }
+        else
+        {
+            A.pile(C.row(r));
+            lA.pile(lC.segment(r,1));
+            uA.pile(uC.segment(r,1));
+        }
+    }
+    return promoted;
+}
+
+bool QPOases_sot::isScreeningViolated(const Eigen::VectorXd& x, const double tolerance) const
+{
+    Eigen::Block<const RowMajorMatrixXd> C = screened_A.get();
+    Eigen::Block<const Eigen::MatrixXd> lC = screened_lA.get();
+    Eigen::Block<const Eigen::MatrixXd> uC = screened_uA.get();
+    for(int r = 0; r < C.rows(); ++r)
+    {
+        // each variable can exceed its bounds by tolerance
+        const double row_tolerance = tolerance*(1. + C.row(r).lpNorm<1>());
+        const double Cx = C.row(r).dot(x);
+        if(Cx < lC(r,0) - row_tolerance || Cx > uC(r,0) + row_tolerance)
+            return true;
+    }
+    return false;
 }
 
 bool QPOases_sot::prepareSoT()
 {
+    if(!_tasks.empty())
+        optimality_A.reset(_tasks[0]->getXSize());
+    optimality_lA.reset(1);
+    optimality_uA.reset(1);
+
+    // the buffers used by solve() are allocated here once for all
+    int optimality_rows = 0;
+    int max_task_rows = 0;
     for(unsigned int i = 0; i < _tasks.size(); ++i)
     {
-        computeCostFunction(_tasks[i], H, g);
+        const int rows = _tasks[i]->getA().rows();
+        if(i < _tasks.size()-1)
+            optimality_rows += rows;
+        max_task_rows = std::max(max_task_rows, rows);
+    }
+    optimality_A.reserve(optimality_rows);
+    optimality_lA.reserve(optimality_rows);
+    optimality_uA.reserve(optimality_rows);
+    tmp_Ax.resize(max_task_rows);
+    if(!_tasks.empty())
+    {
+        const int n = _tasks[0]->getXSize();
+        tmp_optimality.resize(n, n + max_task_rows);
+        optimality_qr = Eigen::ColPivHouseholderQR<Eigen::MatrixXd>(n, n + max_task_rows);
+        tmp_Q.resize(n, n);
+        tmp_householder.resize(n);
+    }
 
+    // global constraints and bounds are common to all the levels: they are aggregated once and
+    // only the constraints of each task are aggregated per level
+    std::list<ConstraintPtr> shared_constraints;
+    if(_globalConstraints)
+        shared_constraints.push_back(_globalConstraints);
+    else if(_bounds && _bounds->isConstraint())
+        shared_constraints.push_back(_bounds);
+    std::string shared_constraints_str = "";
+    if(!shared_constraints.empty())
+        shared_constraints_str = shared_constraints.front()->getConstraintID();
+    if(_bounds && _bounds->isBound())   // if it is a constraint, it has already been added above
+        shared_constraints.push_back(_bounds);
+    if(!_tasks.empty())
+        _shared_constraints.reset(new OpenSoT::constraints::Aggregated(shared_constraints, _tasks[0]->getXSize()));
+
+    // the constraints of all the levels are aggregated first: in this way the sizes of all the
+    // problems are known and they are placed, with their factorizations, in a single arena
+    std::vector<std::string> constraints_ids;
+    unsigned int arena_size = 0;
+    int previous_task_rows = 0;
+    int max_level_constraints = 0;
+    for(unsigned int i = 0; i < _tasks.size(); ++i)
+    {
         OpenSoT::constraints::Aggregated constraints_task_i(_tasks[i]->getConstraints(), _tasks[i]->getXSize());
-        if(_globalConstraints){
-            constraints_task_i.getConstraintsList().push_back(_globalConstraints);
-            constraints_task_i.generateAll();}
-        else if(_bounds && _bounds->isConstraint())
-        {
-            constraints_task_i.getConstraintsList().push_back(_bounds);
-            constraints_task_i.generateAll();
-        }
 
-        std::string constraints_str = constraints_task_i.getConstraintID();
+        std::string constraints_str = "";
+        if(!_tasks[i]->getConstraints().empty())
+            constraints_str = constraints_task_i.getConstraintID();
+        if(!constraints_str.empty() && !shared_constraints_str.empty())
+            constraints_str = constraints_str + "+";
+        constraints_ids.push_back(constraints_str + shared_constraints_str);
+
+        constraints_task.push_back(constraints_task_i);
 
-        A.set(constraints_task_i.getAineq());
-        lA.set(constraints_task_i.getbLowerBound());
-        uA.set(constraints_task_i.getbUpperBound());
+        const int level_constraints = constraints_task_i.getAineqRowMajor().rows() +
+                                      _shared_constraints->getAineqRowMajor().rows();
+        max_level_constraints = std::max(max_level_constraints, level_constraints);
+        const int number_of_constraints = level_constraints + previous_task_rows;
+        arena_size += QPOasesProblem::getArenaSize(_tasks[i]->getXSize(), number_of_constraints);
+        previous_task_rows += _tasks[i]->getA().rows();
+    }
+    _arena.reset(new qpOASES::Arena(arena_size));
+
+    if(!_tasks.empty())
+    {
+        screened_A.reset(_tasks[0]->getXSize());
+        screened_lA.reset(1);
+        screened_uA.reset(1);
+    }
+    screened_A.reserve(max_level_constraints);
+    screened_lA.reserve(max_level_constraints);
+    screened_uA.reserve(max_level_constraints);
+
+    _hessians.resize(_tasks.size());
+    _nullspace_levels.resize(_tasks.size());
+    for(unsigned int i = 0; i < _tasks.size(); ++i)
+    {
+        _hessians[i].valid = false;
+        computeLevelCostFunction(i);
+
+        std::string constraints_str = constraints_ids[i];
+
+        pileLevelConstraints(i, false);
         if(i > 0)
         {
-            Eigen::MatrixXd _tmp_A;
-            Eigen::VectorXd _tmp_lA, _tmp_uA;
             for(unsigned int j = 0; j < i; ++j)
             {
-                computeOptimalityConstraint(_tasks[j], _qp_stack_of_tasks[j], _tmp_A, _tmp_lA, _tmp_uA);
-
-                if( j == i-1)
-                {
-                    tmp_A.push_back(_tmp_A);
-                    tmp_lA.push_back(_tmp_lA);
-                    tmp_uA.push_back(_tmp_uA);
-                }
-
                 if(!constraints_str.compare("") == 0)
                     constraints_str = constraints_str + "+";
                 constraints_str = constraints_str + _tasks[j]->getTaskID() + "_optimality";
-
-                A.pile(tmp_A[j]);
-                lA.pile(tmp_lA[j]);
-                uA.pile(tmp_uA[j]);
             }
-        }
 
-        if(_bounds && _bounds->isBound()){   // if it is a constraint, it has already been added in #74
-            constraints_task_i.getConstraintsList().push_back(_bounds);
-            constraints_task_i.generateAll();}
-        l = constraints_task_i.getLowerBound();
-        u = constraints_task_i.getUpperBound();
+            A.pile(optimality_A.get());
+            lA.pile(optimality_lA.get());
+            uA.pile(optimality_uA.get());
+        }
 
         QPOasesProblem problem_i(_tasks[i]->getXSize(), A.rows(), (OpenSoT::HessianType)(_tasks[i]->getHessianAtype()),
-                                 _epsRegularisation);
+                                 _epsRegularisation, _arena);
 
-        if(problem_i.initProblem(H, g, A.generate_and_get(), lA.generate_and_get(), uA.generate_and_get(), l, u)){
+        if(problem_i.initProblem(_hessians[i].H, g, A.generate_and_get(), lA.generate_and_get(), uA.generate_and_get(), l, u)){
             _qp_stack_of_tasks.push_back(problem_i);
             std::string bounds_string = "";
             if(_bounds)
@@ -144,72 +494,335 @@ bool QPOases_sot::prepareSoT()
             XBot::Logger::error("ERROR: INITIALIZING STACK %i \n", i);
             return false;}
 
-        constraints_task.push_back(constraints_task_i);
+        _stats.push_back(LevelStats());
+        _stats.back().problem = _qp_stack_of_tasks[i].getStats();
+        _stats_names.push_back("stats_"+std::to_string(i));
+
+        if(i < _tasks.size()-1)
+            computeOptimalityConstraint(_tasks[i], _qp_stack_of_tasks[i], optimality_A, optimality_lA, optimality_uA);
     }
     return true;
 }
 
 bool QPOases_sot::solve(Eigen::VectorXd &solution)
 {
+    if(_nullspace_mode)
+        return solveNullSpace(solution);
+
+    // optimality constraints of task i are appended right after task i is solved
+    optimality_A.reset();
+    optimality_lA.reset();
+    optimality_uA.reset();
+
+    bool shared_constraints_generated = false;
     for(unsigned int i = 0; i < _tasks.size(); ++i)
     {
-        if(_active_stacks[i])
+        LevelStats& stats = _stats[i];
+        stats.resetTimes();
+        stats.skipped = false;
+        stats.screened_constraints = 0;
+        stats.promoted_constraints = 0;
+
+        // the compressed optimality constraints of the higher priority tasks fix all the variables
+        if(_active_stacks[i] && _optimality_compression && optimality_A.rows() == (int)_tasks[i]->getXSize())
         {
-            computeCostFunction(_tasks[i], H, g);
-            if(!_qp_stack_of_tasks[i].updateTask(H, g))
-                return false;
+            stats.skipped = true;
+            continue;
+        }
 
-            OpenSoT::constraints::Aggregated& constraints_task_i = constraints_task[i];
-            constraints_task_i.generateAll();
+        if(_active_stacks[i])
+        {
+            // global constraints and bounds are generated once, by the first active level
+            Clock::time_point start = Clock::now();
+            if(!shared_constraints_generated)
+            {
+                _shared_constraints->generateAll();
+                shared_constraints_generated = true;
+            }
+            constraints_task[i].generateAll();
+            stats.promoted_constraints = pileLevelConstraints(i, true);
+            stats.screened_constraints = screened_A.rows();
+            stats.constraints_time = elapsed(start);
 
-            A.set(constraints_task_i.getAineq());
-            lA.set(constraints_task_i.getbLowerBound());
-            uA.set(constraints_task_i.getbUpperBound());
+            start = Clock::now();
             if(i > 0)
             {
-                for(unsigned int j = 0; j < i; ++j)
+                A.pile(optimality_A.get());
+                lA.pile(optimality_lA.get());
+                uA.pile(optimality_uA.get());
+            }
+            stats.optimality_time = elapsed(start);
+
+            // a level with only bounds and identity Hessian is solved in closed form: H is not needed.
+            // A masked or deactivated task is not JT_IDENTITY anymore, so H is computed again
+            const bool closed_form = A.rows() == 0 && _qp_stack_of_tasks[i].isClosedForm() &&
+                                     _qp_stack_of_tasks[i].getH().cols() == _tasks[i]->getXSize() &&
+                                     _tasks[i]->getJacobianType() == OpenSoT::JT_IDENTITY &&
+                                     _tasks[i]->getHessianAtype() == OpenSoT::HST_IDENTITY &&
+                                     _tasks[i]->getWeightType() == OpenSoT::WT_IDENTITY;
+
+            // H is computed again only if A or W of the task changed
+            start = Clock::now();
+            if(closed_form)
+                computeGradient(_tasks[i], g);
+            else
+                computeLevelCostFunction(i);
+            stats.cost_function_time = elapsed(start);
+
+            start = Clock::now();
+            if(_qp_stack_of_tasks[i].getH().cols() != _tasks[i]->getXSize())
+            {
+                // the problem was solved in nullspace mode: it has to be initialized again
+                if(!_qp_stack_of_tasks[i].initProblem(_hessians[i].H, g, A.generate_and_get(),
+                                    lA.generate_and_get(), uA.generate_and_get(), l, u))
+                    return false;
+            }
+            else
+            {
+                if(closed_form)
                 {
-                    if(_active_stacks[j])
-                        computeOptimalityConstraint(_tasks[j], _qp_stack_of_tasks[j], tmp_A[j], tmp_lA[j], tmp_uA[j]);
-                    else
-                    {
-                        //Here we consider fake optimality constraints:
-                        //
-                        //    -1 <= 0x <= 1
-                        tmp_A[j].setZero(_tasks[j]->getA().rows(), _tasks[j]->getA().cols());
-                        tmp_lA[j].setConstant(_tasks[j]->getA().rows(), -1.0);
-                        tmp_uA[j].setConstant(_tasks[j]->getA().rows(), 1.0);
-                    }
-                    A.pile(tmp_A[j]);
-                    lA.pile(tmp_lA[j]);
-                    uA.pile(tmp_uA[j]);
+                    if(!_qp_stack_of_tasks[i].updateTask(g))
+                        return false;
                 }
-            }
+                else if(!_qp_stack_of_tasks[i].updateTask(_hessians[i].H, g))
+                    return false;
 
-            if(!_qp_stack_of_tasks[i].updateConstraints(A.generate_and_get(),
-                                    lA.generate_and_get(), uA.generate_and_get()))
-                return false;
+                if(!_qp_stack_of_tasks[i].updateConstraints(A.generate_and_get(),
+                                        lA.generate_and_get(), uA.generate_and_get()))
+                    return false;
+
+
+                if(l.size() > 0) // bounds specified everywhere will work
+                {
+                    if(!_qp_stack_of_tasks[i].updateBounds(l, u))
+                        return false;
+                }
 
+                if(!_qp_stack_of_tasks[i].solve())
+                    return false;
+            }
 
-            if(constraints_task_i.hasBounds()) // bounds specified everywhere will work
+            // since the screened rows can not become active within the bounds, the solution can violate
+            // them only with a negative margin: in this case the level is solved again with all its
+            // constraints, and with the bounds before the promotion of the constraints
+            if(stats.screened_constraints > 0 &&
+               isScreeningViolated(_qp_stack_of_tasks[i].getSolution(),
+                                   _qp_stack_of_tasks[i].getOptions().boundTolerance))
             {
-                if(!_qp_stack_of_tasks[i].updateBounds(constraints_task_i.getLowerBound(), constraints_task_i.getUpperBound()))
+                ++stats.screening_resolve_counter;
+                pileLevelConstraints(i, false);
+                stats.screened_constraints = 0;
+                stats.promoted_constraints = 0;
+                if(i > 0)
+                {
+                    A.pile(optimality_A.get());
+                    lA.pile(optimality_lA.get());
+                    uA.pile(optimality_uA.get());
+                }
+                if(!_qp_stack_of_tasks[i].updateConstraints(A.generate_and_get(),
+                                        lA.generate_and_get(), uA.generate_and_get()))
+                    return false;
+                if(l.size() > 0 && !_qp_stack_of_tasks[i].updateBounds(l, u))
+                    return false;
+                if(!_qp_stack_of_tasks[i].solve())
                     return false;
             }
 
-            if(!_qp_stack_of_tasks[i].solve())
-                return false;
+            stats.solve_time = elapsed(start);
+            stats.problem = _qp_stack_of_tasks[i].getStats();
 
             solution = _qp_stack_of_tasks[i].getSolution();
+
+            if(i < _tasks.size()-1)
+            {
+                start = Clock::now();
+                if(_optimality_compression)
+                    computeCompressedOptimalityConstraint(_tasks[i], _qp_stack_of_tasks[i]);
+                else
+                    computeOptimalityConstraint(_tasks[i], _qp_stack_of_tasks[i], optimality_A, optimality_lA, optimality_uA);
+                stats.optimality_time += elapsed(start);
+            }
+        }
+        else if(i < _tasks.size()-1 && !_optimality_compression)
+        {
+            //Here we consider fake optimality constraints:
+            //
+            //    -1 <= 0x <= 1
+            //(compressed optimality constraints simply skip the task)
+            const int rows = _tasks[i]->getA().rows();
+            optimality_A.pile(Eigen::MatrixXd::Zero(rows, _tasks[i]->getXSize()));
+            optimality_lA.pile(Eigen::VectorXd::Constant(rows, -1.0));
+            optimality_uA.pile(Eigen::VectorXd::Constant(rows, 1.0));
+        }
+    }
+    return true;
+}
+
+bool QPOases_sot::solveNullSpace(Eigen::VectorXd &solution)
+{
+    // until a task is solved the nullspace basis is the identity
+    const Eigen::MatrixXd* Z = NULL;
+    bool shared_constraints_generated = false;
+
+    for(unsigned int i = 0; i < _tasks.size(); ++i)
+    {
+        _stats[i].resetTimes();
+        _stats[i].skipped = false;
+    }
+
+    for(unsigned int i = 0; i < _tasks.size(); ++i)
+    {
+        if(!_active_stacks[i])
+            continue;
+
+        LevelStats& stats = _stats[i];
+
+        // the optimality of the higher priority tasks leaves no freedom
+        if(Z && Z->cols() == 0)
+        {
+            stats.skipped = true;
+            continue;
+        }
+
+        const TaskPtr& task = _tasks[i];
+        NullSpaceLevel& level = _nullspace_levels[i];
+        Clock::time_point start = Clock::now();
+        if(!shared_constraints_generated)
+        {
+            _shared_constraints->generateAll();
+            shared_constraints_generated = true;
+        }
+        constraints_task[i].generateAll();
+        pileLevelConstraints(i, false);
+        stats.constraints_time = elapsed(start);
+
+        if(!Z)
+        {
+            start = Clock::now();
+            computeCostFunction(task, H, g);
+            stats.cost_function_time = elapsed(start);
+
+            start = Clock::now();
+            if(!solveNullSpaceProblem(i, H, g, A.generate_and_get(), lA.generate_and_get(), uA.generate_and_get(), l, u))
+                return false;
+            stats.solve_time = elapsed(start);
+
+            nullspace_x = _qp_stack_of_tasks[i].getSolution();
         }
         else
         {
-            //Here we do nothing
+            // cost function in the reduced variables: ||A(x* + Zy) - b||_W
+            start = Clock::now();
+            level.AZ.noalias() = task->getA()*(*Z);
+            level.b = task->getb();
+            level.b.noalias() -= task->getA()*nullspace_x;
+
+            level.H.resize(Z->cols(), Z->cols());
+            if(task->getWeightType() == OpenSoT::WT_IDENTITY)
+            {
+                level.H.triangularView<Eigen::Upper>() = level.AZ.transpose()*level.AZ;
+                level.g.noalias() = -1.0 * level.AZ.transpose() * level.b;
+            }
+            else
+            {
+                if(task->getWeightType() == OpenSoT::WT_DIAGONAL)
+                    level.WAZ.noalias() = task->getWeight().diagonal().asDiagonal()*level.AZ;
+                else
+                    level.WAZ.noalias() = task->getWeight()*level.AZ;
+                level.H.triangularView<Eigen::Upper>() = level.AZ.transpose()*level.WAZ;
+                level.g.noalias() = -1.0 * level.WAZ.transpose() * level.b;
+            }
+            level.H = level.H.selfadjointView<Eigen::Upper>();
+            stats.cost_function_time = elapsed(start);
+
+            // constraints in the reduced variables: lA - Cx* <= CZy <= uA - Cx*
+            // and bounds, which become constraints: l - x* <= Zy <= u - x*
+            // (the buffers only grow, so a varying number of constraints does not allocate them again)
+            start = Clock::now();
+            const int rows = A.rows();
+            const int reduced_rows = rows + l.size();
+            if(level.CZ.rows() < reduced_rows || level.CZ.cols() != Z->cols())
+                level.CZ.resize(reduced_rows, Z->cols());
+            if(level.lA.size() < reduced_rows)
+            {
+                level.lA.resize(reduced_rows);
+                level.uA.resize(reduced_rows);
+            }
+            if(level.Cx.size() < rows)
+                level.Cx.resize(rows);
+            level.CZ.topRows(rows).noalias() = A.get()*(*Z);
+            level.Cx.head(rows).noalias() = A.get()*nullspace_x;
+            level.lA.head(rows) = lA.get() - level.Cx.head(rows);
+            level.uA.head(rows) = uA.get() - level.Cx.head(rows);
+            if(l.size() > 0)
+            {
+                level.CZ.middleRows(rows, l.size()) = *Z;
+                level.lA.segment(rows, l.size()) = l - nullspace_x;
+                level.uA.segment(rows, l.size()) = u - nullspace_x;
+            }
+            stats.constraints_time += elapsed(start);
+
+            start = Clock::now();
+            if(!solveNullSpaceProblem(i, level.H, level.g, level.CZ.topRows(reduced_rows),
+                                      level.lA.head(reduced_rows), level.uA.head(reduced_rows),
+                                      nullspace_l, nullspace_u))
+                return false;
+            stats.solve_time = elapsed(start);
+
+            nullspace_x.noalias() += (*Z)*_qp_stack_of_tasks[i].getSolution();
+        }
+
+        stats.problem = _qp_stack_of_tasks[i].getStats();
+        solution = nullspace_x;
+
+        if(i < _tasks.size()-1)
+        {
+            start = Clock::now();
+            updateNullSpaceBasis(i, Z ? level.AZ : task->getA(), Z);
+            Z = &level.Z;
+            stats.optimality_time = elapsed(start);
         }
     }
     return true;
 }
 
+bool QPOases_sot::solveNullSpaceProblem(const unsigned int i, const Eigen::MatrixXd& H, const Eigen::VectorXd& g,
+                                        const Eigen::Ref<const RowMajorMatrixXd>& A,
+                                        const Eigen::Ref<const Eigen::VectorXd>& lA,
+                                        const Eigen::Ref<const Eigen::VectorXd>& uA,
+                                        const Eigen::VectorXd& l, const Eigen::VectorXd& u)
+{
+    QPOasesProblem& problem = _qp_stack_of_tasks[i];
+
+    if(problem.getH().cols() != H.cols() || problem.getl().size() != l.size())
+        return problem.initProblem(H, g, A, lA, uA, l, u);
+
+    if(!problem.updateTask(H, g))
+        return false;
+    if(!problem.updateConstraints(A, lA, uA))
+        return false;
+    if(!problem.updateBounds(l, u))
+        return false;
+    return problem.solve();
+}
+
+void QPOases_sot::updateNullSpaceBasis(const unsigned int i, const Eigen::MatrixXd& AZ, const Eigen::MatrixXd* Z)
+{
+    NullSpaceLevel& level = _nullspace_levels[i];
+
+    // the last columns of Q span the nullspace of AZ
+    level.qr.setThreshold(_nullspace_rank_threshold);
+    level.qr.compute(AZ.transpose());
+    const int rank = level.qr.rank();
+    const int nullity = AZ.cols() - rank;
+
+    computeQColumns(level.qr, rank, nullity);
+    if(!Z)
+        level.Z = tmp_Q.topLeftCorner(AZ.cols(), nullity);
+    else
+        level.Z.noalias() = (*Z)*tmp_Q.topLeftCorner(AZ.cols(), nullity);
+}
+
 bool QPOases_sot::setOptions(const unsigned int i, const qpOASES::Options &opt)
 {
     if(i > _qp_stack_of_tasks.size()){
@@ -237,6 +850,49 @@ void QPOases_sot::setActiveStack(const unsigned int i, const bool flag)
         _active_stacks[i] = flag;
 }
 
+bool QPOases_sot::setConstraintsCapacity(const unsigned int i, const int capacity)
+{
+    if(i >= _qp_stack_of_tasks.size()){
+        XBot::Logger::error("ERROR Index out of range! \n");
+        return false;}
+
+    // the pilers are shared among the tasks, they are reserved for the biggest capacity
+    A.reserve(capacity);
+    lA.reserve(capacity);
+    uA.reserve(capacity);
+
+    return _qp_stack_of_tasks[i].setConstraintsCapacity(capacity);
+}
+
+void QPOases_sot::setNullSpaceMode(const bool flag, const double rank_threshold)
+{
+    _nullspace_mode = flag;
+    _nullspace_rank_threshold = rank_threshold;
+}
+
+void QPOases_sot::setOptimalityCompression(const bool flag, const double rank_threshold)
+{
+    _optimality_compression = flag;
+    _optimality_rank_threshold = rank_threshold;
+}
+
+void QPOases_sot::setConstraintScreening(const bool flag, const double margin)
+{
+    _constraint_screening = flag;
+    _screening_margin = margin;
+}
+
+void QPOases_sot::setBoundsPromotion(const bool flag)
+{
+    _bounds_promotion = flag;
+}
+
+void QPOases_sot::setDirectKKT(const bool flag, const double tolerance)
+{
+    for(unsigned int i = 0; i < _qp_stack_of_tasks.size(); ++i)
+        _qp_stack_of_tasks[i].setDirectKKT(flag, tolerance);
+}
+
 void QPOases_sot::activateAllStacks()
 {
     _active_stacks.assign(_active_stacks.size(), true);
@@ -245,6 +901,21 @@ void QPOases_sot::activateAllStacks()
 
 void QPOases_sot::_log(XBot::MatLogger::Ptr logger)
 {
+    tmp_stats.resize(24);
     for(unsigned int i = 0; i < _qp_stack_of_tasks.size(); ++i)
+    {
         _qp_stack_of_tasks[i].log(logger,i);
+
+        const LevelStats& stats = _stats[i];
+        tmp_stats<<stats.cost_function_time, stats.constraints_time, stats.optimality_time, stats.solve_time,
+                   stats.problem.hotstart_time, stats.problem.warmstart_time, stats.problem.init_time,
+                   stats.problem.nWSR, stats.problem.active_bounds, stats.problem.active_constraints,
+                   stats.problem.nV, stats.problem.nC, stats.problem.memory,
+                   stats.problem.hotstart_counter, stats.problem.warmstart_counter, stats.problem.init_counter,
+                   stats.problem.direct_time, stats.problem.direct_counter,
+                   stats.problem.vectors_hotstart_counter, stats.skipped,
+                   stats.screened_constraints, stats.screening_resolve_counter, stats.promoted_constraints,
+                   stats.problem.closed_form_counter;
+        logger->add(_stats_names[i], tmp_stats);
+    }
 }
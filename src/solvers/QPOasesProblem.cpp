@@ -3,10 +3,11 @@
 #include <ctime>
 #include <qpOASES/Utils.hpp>
 #include <fstream>
-#include <boost/make_shared.hpp>
 #include <iostream>
 #include <qpOASES/Matrices.hpp>
 #include <XBotInterface/Logger.hpp>
+#include <chrono>
+#include <new>
 
 
 #define GREEN "\033[0;32m"
@@ -16,18 +17,56 @@
 
 using namespace OpenSoT::solvers;
 
+typedef std::chrono::steady_clock Clock;
+
+static inline double elapsed(const Clock::time_point& start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+namespace {
+
+/**
+ * Destroys a problem placed in an arena; the arena is kept alive as long as the problem.
+ */
+struct ArenaDeleter
+{
+    ArenaDeleter(const boost::shared_ptr<qpOASES::Arena>& arena): _arena(arena) {}
+
+    void operator()(qpOASES::QProblemB* problem) const
+    {
+        problem->~QProblemB();
+    }
+
+    boost::shared_ptr<qpOASES::Arena> _arena;
+};
+
+}
+
 QPOasesProblem::QPOasesProblem(const int number_of_variables,
                                const int number_of_constraints,
-                               OpenSoT::HessianType hessian_type, const double eps_regularisation):
-    _problem(new qpOASES::SQProblem(number_of_variables,
-                                    number_of_constraints,
-                                    (qpOASES::HessianType)(hessian_type))),
+                               OpenSoT::HessianType hessian_type, const double eps_regularisation,
+                               const boost::shared_ptr<qpOASES::Arena>& arena):
+    _arena(arena),
+    _sq_problem(NULL),
+    _sq_problem_b(NULL),
     _bounds(new qpOASES::Bounds()),
     _constraints(new qpOASES::Constraints()),
     _nWSR(132),
     _epsRegularisation(eps_regularisation),
+    _is_H_changed(true),
+    _is_A_changed(true),
+    _is_initialised(false),
+    _qpoases_H_data(NULL),
+    _qpoases_A_data(NULL),
+    _constraints_capacity(0),
+    _number_of_constraints(0),
+    _identity_hessian(false),
     _solution(number_of_variables), _dual_solution(number_of_variables),
-    _opt(new qpOASES::Options())
+    _reset_stats_times(true),
+    _opt(new qpOASES::Options()),
+    _direct_kkt(false),
+    _direct_kkt_tolerance(1e-9)
 {
     _H.setZero(0,0);
     _g.setZero(0);
@@ -36,11 +75,78 @@ QPOasesProblem::QPOasesProblem(const int number_of_variables,
     _uA.setZero(0);
     _l.setZero(0);
     _u.setZero(0);
+    createProblem(number_of_variables, number_of_constraints, hessian_type);
     setDefaultOptions();}
 
 QPOasesProblem::~QPOasesProblem()
 {}
 
+unsigned int QPOasesProblem::getArenaSize(const int number_of_variables, const int number_of_constraints)
+{
+    if(number_of_constraints == 0)
+        return qpOASES::Arena::getBlockSize(sizeof(qpOASES::SQProblemB)) +
+               qpOASES::SQProblemB::getArenaSize(number_of_variables);
+
+    return qpOASES::Arena::getBlockSize(sizeof(qpOASES::SQProblem)) +
+           qpOASES::SQProblem::getArenaSize(number_of_variables, number_of_constraints);
+}
+
+void QPOasesProblem::createProblem(const int number_of_variables,
+                                   const int number_of_constraints,
+                                   const OpenSoT::HessianType hessian_type)
+{
+    const qpOASES::HessianType ht = (qpOASES::HessianType)(hessian_type);
+    const unsigned int size = getArenaSize(number_of_variables, number_of_constraints);
+    const bool in_arena = _arena && _arena->getUsed() + size <= _arena->getSize();
+
+    if(number_of_constraints == 0)
+    {
+        _sq_problem = NULL;
+        if(in_arena)
+        {
+            void* memory = _arena->getBlock(sizeof(qpOASES::SQProblemB));
+            _sq_problem_b = new (memory) qpOASES::SQProblemB(number_of_variables, ht, _arena.get());
+            _problem.reset(_sq_problem_b, ArenaDeleter(_arena));
+        }
+        else
+        {
+            _sq_problem_b = new qpOASES::SQProblemB(number_of_variables, ht);
+            _problem.reset(_sq_problem_b);
+        }
+
+        // a SQProblemB has no constraints to report
+        _constraints->init(0);
+    }
+    else
+    {
+        _sq_problem_b = NULL;
+        if(in_arena)
+        {
+            void* memory = _arena->getBlock(sizeof(qpOASES::SQProblem));
+            _sq_problem = new (memory) qpOASES::SQProblem(number_of_variables, number_of_constraints,
+                                                          ht, _arena.get());
+            _problem.reset(_sq_problem, ArenaDeleter(_arena));
+        }
+        else
+        {
+            _sq_problem = new qpOASES::SQProblem(number_of_variables, number_of_constraints, ht);
+            _problem.reset(_sq_problem);
+        }
+    }
+}
+
+bool QPOasesProblem::isClosedForm() const
+{
+    return _sq_problem_b && _identity_hessian;
+}
+
+int QPOasesProblem::getProblemNC() const
+{
+    if(_sq_problem)
+        return _sq_problem->getNC();
+    return 0;
+}
+
 void QPOasesProblem::setDefaultOptions()
 {
     qpOASES::Options opt;
@@ -70,42 +176,82 @@ qpOASES::Options QPOasesProblem::getOptions(){
     return _problem->getOptions();}
 
 bool QPOasesProblem::initProblem(const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
-                                 const Eigen::MatrixXd &A,
+                                 const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd> &A,
                                  const Eigen::VectorXd &lA, const Eigen::VectorXd &uA,
                                  const Eigen::VectorXd &l, const Eigen::VectorXd &u)
 {
-    _H = H; _g = g; _A = A; _lA = lA; _uA = uA; _l = l; _u = u;
-    checkINFTY();
-
-
-    if(!(_l.rows() == _u.rows())){
-        XBot::Logger::error("l size: %i \n", _l.rows());
-        XBot::Logger::error("u size: %i \n", _u.rows());
-        assert(_l.rows() == _u.rows());
+    if(!(l.rows() == u.rows())){
+        XBot::Logger::error("l size: %i \n", l.rows());
+        XBot::Logger::error("u size: %i \n", u.rows());
+        assert(l.rows() == u.rows());
         return false;}
-    if(!(_lA.rows() == _A.rows())){
-        XBot::Logger::error("lA size: %i \n", _lA.rows());
-        XBot::Logger::error("A rows: %i \n", _A.rows());
-        assert(_lA.rows() == _A.rows());
+    if(!(lA.rows() == A.rows())){
+        XBot::Logger::error("lA size: %i \n", lA.rows());
+        XBot::Logger::error("A rows: %i \n", A.rows());
+        assert(lA.rows() == A.rows());
         return false;}
-    if(!(_lA.rows() == _uA.rows())){
-        XBot::Logger::error("lA size: %i \n", _lA.rows());
-        XBot::Logger::error("uA size: %i \n", _uA.rows());
-        assert(_lA.rows() == _uA.rows());
+    if(!(lA.rows() == uA.rows())){
+        XBot::Logger::error("lA size: %i \n", lA.rows());
+        XBot::Logger::error("uA size: %i \n", uA.rows());
+        assert(lA.rows() == uA.rows());
         return false;}
 
+    _H = H; _g = g; _l = l; _u = u;
+    _identity_hessian = _H.isIdentity(qpOASES::EPS);
+    _is_H_changed = true;
+    copyConstraints(A, lA, uA);
+    _is_A_changed = true;
+
+    // the internal problem has to match the size of the data (e.g. in fixed-capacity mode)
+    if(_problem->getNV() != _H.cols() || getProblemNC() != _A.rows())
+        resetProblem();
+
+    resetStatsTimes();
+    bool success = initInternalProblem();
+    _reset_stats_times = true;
+    return success;
+}
+
+bool QPOasesProblem::initInternalProblem()
+{
+    checkINFTY();
+
+    if(isClosedForm())
+    {
+        Clock::time_point start = Clock::now();
+        const bool success = solveClosedForm();
+        _stats.init_time += elapsed(start);
+        if(success)
+            ++_stats.closed_form_counter;
+        return success;
+    }
+
+    // the Hessian was declared identity (e.g. for the closed form) but changed since:
+    // qpOASES determines its type again instead of ignoring it
+    if(_problem->getHessianType() == qpOASES::HST_IDENTITY && !_identity_hessian)
+        _problem->setHessianType(qpOASES::HST_UNKNOWN);
+
     int nWSR = _nWSR;
 
     /**
-     * this typedef is needed since qpOASES wants RoWMajor organization
+     * _A is stored RowMajor since qpOASES wants RoWMajor organization
      * of matrices. Thanks to Arturo Laurenzi for the help finding this issue!
      */
-    qpOASES::returnValue val =_problem->init(_H.data(),_g.data(),
-                       Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>(_A).data(),
+    Clock::time_point start = Clock::now();
+    qpOASES::returnValue val;
+    if(_sq_problem_b)
+        val = _sq_problem_b->init(copyHessian(),_g.data(),
+                       _l.data(), _u.data(),
+                       nWSR,0);
+    else
+        val = _sq_problem->init(copyHessian(),_g.data(),
+                       _A.data(),
                        _l.data(), _u.data(),
                        _lA.data(),_uA.data(),
                        nWSR,0);
+    _stats.init_time += elapsed(start);
 
+    _is_initialised = (val == qpOASES::SUCCESSFUL_RETURN);
     if(val != qpOASES::SUCCESSFUL_RETURN)
     {
 #ifndef NDEBUG
@@ -124,23 +270,65 @@ bool QPOasesProblem::initProblem(const Eigen::MatrixXd &H, const Eigen::VectorXd
     if(_solution.rows() != _problem->getNV())
         _solution.resize(_problem->getNV());
 
-    if(_dual_solution.rows() != _problem->getNV() + _problem->getNC())
-        _dual_solution.resize(_problem->getNV() + _problem->getNC());
+    if(_dual_solution.rows() != _problem->getNV() + getProblemNC())
+        _dual_solution.resize(_problem->getNV() + getProblemNC());
 
     //We get the solution
     qpOASES::returnValue success = _problem->getPrimalSolution(_solution.data());
     _problem->getDualSolution(_dual_solution.data());
     _problem->getBounds(*_bounds);
-    _problem->getConstraints(*_constraints);
+    if(_sq_problem)
+        _sq_problem->getConstraints(*_constraints);
 
     if(success != qpOASES::SUCCESSFUL_RETURN){
 #ifndef NDEBUG
         XBot::Logger::error("ERROR GETTING PRIMAL SOLUTION IN INITIALIZATION! ERROR %i \n", success);
 #endif
         return false;}
+
+    _is_H_changed = false;
+    _is_A_changed = false;
+    _qpoases_H_data = _H_regularised.data();
+    _qpoases_A_data = _A.data();
+
+    ++_stats.init_counter;
+    updateStats(nWSR);
     return true;
 }
 
+double* QPOasesProblem::copyHessian()
+{
+    _H_regularised = _H;
+    return _H_regularised.data();
+}
+
+void QPOasesProblem::resetStatsTimes()
+{
+    if(_reset_stats_times)
+    {
+        _stats.hotstart_time = 0.;
+        _stats.warmstart_time = 0.;
+        _stats.init_time = 0.;
+        _stats.direct_time = 0.;
+        _reset_stats_times = false;
+    }
+}
+
+void QPOasesProblem::updateStats(const int nWSR)
+{
+    _stats.nWSR = nWSR;
+    _stats.active_bounds = _bounds->getNFX();
+    _stats.active_constraints = _constraints->getNAC();
+    _stats.nV = _problem->getNV();
+    _stats.nC = getProblemNC();
+
+    const unsigned long nT = std::min(_stats.nV, _stats.nC);
+    const unsigned long nQ = _sq_problem ? _stats.nV : 0;
+    _stats.memory = sizeof(double)*(_H.size() + _H_regularised.size() + _g.size() + _A.size() + _lA.size() + _uA.size() +
+                                    _l.size() + _u.size() + _solution.size() + _dual_solution.size() +
+                                    (_stats.nV + nQ)*_stats.nV + nT*nT); // R, Q and T of qpOASES
+}
+
 bool QPOasesProblem::updateTask(const Eigen::MatrixXd &H, const Eigen::VectorXd &g)
 {
     if(!(_g.rows() == _H.rows())){
@@ -155,7 +343,13 @@ bool QPOasesProblem::updateTask(const Eigen::MatrixXd &H, const Eigen::VectorXd
 
     if(_H.rows() == H.rows())
     {
-        _H = H;
+        // an unchanged H keeps the factorizations of qpOASES
+        if(!(_H == H))
+        {
+            _H = H;
+            _identity_hessian = _H.isIdentity(qpOASES::EPS);
+            _is_H_changed = true;
+        }
         _g = g;
 
         return true;
@@ -164,21 +358,27 @@ bool QPOasesProblem::updateTask(const Eigen::MatrixXd &H, const Eigen::VectorXd
     {
         _H = H;
         _g = g;
+        _identity_hessian = _H.isIdentity(qpOASES::EPS);
+        _is_H_changed = true;
 
-        qpOASES::HessianType hessian_type = _problem->getHessianType();
-        int number_of_variables = _H.cols();
-        int number_of_constraints = _A.rows();
-        _problem.reset();
-        _problem = boost::shared_ptr<qpOASES::SQProblem> (new qpOASES::SQProblem(
-                                                              number_of_variables,
-                                                              number_of_constraints,
-                                                              hessian_type));
-        _problem->setOptions(*_opt.get());
-        return initProblem(_H, _g, _A, _lA, _uA, _l, _u);
+        resetProblem();
+        resetStatsTimes();
+        return initInternalProblem();
     }
 }
 
-bool QPOasesProblem::updateConstraints(const Eigen::Ref<const Eigen::MatrixXd>& A, 
+bool QPOasesProblem::updateTask(const Eigen::VectorXd &g)
+{
+    if(!(g.rows() == _g.rows())){
+        std::cout<<RED<<"g size: "<<g.rows()<<DEFAULT<<std::endl;
+        std::cout<<RED<<"should be: "<<_g.rows()<<DEFAULT<<std::endl;
+        return false;}
+
+    _g = g;
+    return true;
+}
+
+bool QPOasesProblem::updateConstraints(const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd>& A,
                                const Eigen::Ref<const Eigen::VectorXd> &lA, 
                                const Eigen::Ref<const Eigen::VectorXd> &uA)
 {
@@ -195,30 +395,109 @@ bool QPOasesProblem::updateConstraints(const Eigen::Ref<const Eigen::MatrixXd>&
         std::cout<<RED<<"uA size: "<<uA.rows()<<DEFAULT<<std::endl;
         return false;}
 
-    if(A.rows() == _A.rows())
-    {
-        _A = A;
-        _lA = lA;
-        _uA = uA;
+    // In fixed-capacity mode the storage keeps its size and the hotstart is preserved
+    if(!copyConstraints(A, lA, uA))
         return true;
+
+    resetProblem();
+    resetStatsTimes();
+    return initInternalProblem();
+}
+
+bool QPOasesProblem::copyConstraints(const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd>& A,
+                                     const Eigen::Ref<const Eigen::VectorXd>& lA,
+                                     const Eigen::Ref<const Eigen::VectorXd>& uA)
+{
+    const int number_of_constraints = A.rows();
+
+    int storage_rows = number_of_constraints;
+    if(_constraints_capacity > 0)
+    {
+        if(number_of_constraints > _constraints_capacity){
+            XBot::Logger::warning("%i constraints exceed the capacity %i, growing it \n",
+                                  number_of_constraints, _constraints_capacity);
+            _constraints_capacity = number_of_constraints;}
+        storage_rows = _constraints_capacity;
     }
-    else
+
+    bool resized = false;
+    if(_A.rows() != storage_rows || _A.cols() != A.cols())
     {
-        _A = A;
-        _lA = lA;
-        _uA = uA;
-
-        qpOASES::HessianType hessian_type = _problem->getHessianType();
-        int number_of_variables = _H.cols();
-        int number_of_constraints = _A.rows();
-        _problem.reset();
-        _problem = boost::shared_ptr<qpOASES::SQProblem> (new qpOASES::SQProblem(
-                                                              number_of_variables,
-                                                              number_of_constraints,
-                                                              hessian_type));
-        _problem->setOptions(*_opt.get());
-        return initProblem(_H, _g, _A, _lA, _uA, _l, _u);
+        resized = (_A.rows() != storage_rows);
+        _A.setZero(storage_rows, A.cols());
+        _lA.setConstant(storage_rows, -qpOASES::INFTY);
+        _uA.setConstant(storage_rows, qpOASES::INFTY);
+        _is_A_changed = true;
     }
+    else if(number_of_constraints < _number_of_constraints)
+    {
+        // rows used so far which are not used anymore become inert
+        const int unused_rows = _number_of_constraints - number_of_constraints;
+        _A.middleRows(number_of_constraints, unused_rows).setZero();
+        _lA.segment(number_of_constraints, unused_rows).setConstant(-qpOASES::INFTY);
+        _uA.segment(number_of_constraints, unused_rows).setConstant(qpOASES::INFTY);
+        _is_A_changed = true;
+    }
+
+    // an unchanged A keeps the factorizations of qpOASES
+    if(!(_A.topRows(number_of_constraints) == A))
+    {
+        _A.topRows(number_of_constraints) = A;
+        _is_A_changed = true;
+    }
+    _lA.head(number_of_constraints) = lA;
+    _uA.head(number_of_constraints) = uA;
+    _number_of_constraints = number_of_constraints;
+
+    return resized;
+}
+
+void QPOasesProblem::resetProblem()
+{
+    OpenSoT::HessianType hessian_type = (OpenSoT::HessianType)(_problem->getHessianType());
+    createProblem(_H.cols(), _A.rows(), hessian_type);
+    _problem->setOptions(*_opt.get());
+    _is_initialised = false;
+}
+
+void QPOasesProblem::setDirectKKT(const bool flag, const double tolerance)
+{
+    _direct_kkt = flag;
+    _direct_kkt_tolerance = tolerance;
+}
+
+bool QPOasesProblem::setConstraintsCapacity(const int capacity)
+{
+    if(capacity < 0 || (capacity > 0 && capacity < _number_of_constraints)){
+        XBot::Logger::error("capacity %i is less than the actual number of constraints %i \n",
+                            capacity, _number_of_constraints);
+        return false;}
+
+    _constraints_capacity = capacity;
+
+    // not initialized yet: the storage is sized in initProblem()
+    if(_H.rows() == 0)
+        return true;
+
+    const int old_rows = _A.rows();
+    const int storage_rows = capacity > 0 ? capacity : _number_of_constraints;
+    if(storage_rows == old_rows)
+        return true;
+
+    // the rows in use are always on top, the ones below are padding
+    _A.conservativeResize(storage_rows, Eigen::NoChange);
+    _lA.conservativeResize(storage_rows);
+    _uA.conservativeResize(storage_rows);
+    if(storage_rows > old_rows)
+    {
+        _A.bottomRows(storage_rows - old_rows).setZero();
+        _lA.tail(storage_rows - old_rows).setConstant(-qpOASES::INFTY);
+        _uA.tail(storage_rows - old_rows).setConstant(qpOASES::INFTY);
+    }
+
+    resetProblem();
+    resetStatsTimes();
+    return initInternalProblem();
 }
 
 bool QPOasesProblem::updateBounds(const Eigen::VectorXd &l, const Eigen::VectorXd &u)
@@ -243,7 +522,7 @@ bool QPOasesProblem::updateBounds(const Eigen::VectorXd &l, const Eigen::VectorX
 }
 
 bool QPOasesProblem::updateProblem(const Eigen::MatrixXd &H, const Eigen::VectorXd &g,
-                                   const Eigen::MatrixXd &A, const Eigen::VectorXd &lA, const Eigen::VectorXd &uA,
+                                   const Eigen::Ref<const OpenSoT::utils::RowMajorMatrixXd> &A, const Eigen::VectorXd &lA, const Eigen::VectorXd &uA,
                                    const Eigen::VectorXd &l, const Eigen::VectorXd &u)
 {
     bool success = true;
@@ -258,11 +537,66 @@ bool QPOasesProblem::solve()
     int nWSR = _nWSR;
     checkINFTY();
 
-    qpOASES::returnValue val =_problem->hotstart(_H.data(),_g.data(),
-                       Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>(_A).data(),
-                        _l.data(), _u.data(),
-                       _lA.data(),_uA.data(),
-                       nWSR,0);
+    resetStatsTimes();
+    _reset_stats_times = true;
+
+    Clock::time_point start = Clock::now();
+    if(isClosedForm())
+    {
+        const bool success = solveClosedForm();
+        _stats.hotstart_time = elapsed(start);
+        if(success)
+            ++_stats.closed_form_counter;
+        return success;
+    }
+
+    if(_direct_kkt && _sq_problem)
+    {
+        const bool success = solveDirectKKT();
+        _stats.direct_time = elapsed(start);
+        if(success)
+        {
+            ++_stats.direct_counter;
+            return true;
+        }
+        start = Clock::now();
+    }
+
+    // so far solved in closed form: there is nothing to hotstart from
+    if(!_is_initialised)
+        return initInternalProblem();
+
+    // if H and A did not change since the last call to qpOASES only the vectors are passed:
+    // the factorizations are kept and the regularised H is the one of the last call
+    const bool vectors_only = !_is_H_changed && _qpoases_H_data == _H_regularised.data() &&
+                              (_sq_problem_b || (!_is_A_changed && _qpoases_A_data == _A.data()));
+    qpOASES::returnValue val;
+    if(_sq_problem_b)
+    {
+        if(vectors_only)
+            val = _sq_problem_b->hotstart(_g.data(),
+                            _l.data(), _u.data(),
+                           nWSR,0);
+        else
+            val = _sq_problem_b->hotstart(copyHessian(),_g.data(),
+                            _l.data(), _u.data(),
+                           nWSR,0);
+    }
+    else
+    {
+        if(vectors_only)
+            val = _sq_problem->hotstart(_g.data(),
+                            _l.data(), _u.data(),
+                           _lA.data(),_uA.data(),
+                           nWSR,0);
+        else
+            val = _sq_problem->hotstart(copyHessian(),_g.data(),
+                           _A.data(),
+                            _l.data(), _u.data(),
+                           _lA.data(),_uA.data(),
+                           nWSR,0);
+    }
+    _stats.hotstart_time = elapsed(start);
 
     if(val != qpOASES::SUCCESSFUL_RETURN){
 #ifndef NDEBUG
@@ -270,45 +604,219 @@ bool QPOasesProblem::solve()
         std::cout<<GREEN<<"RETRYING INITING WITH WARMSTART"<<DEFAULT<<std::endl;
 #endif
 
-        val =_problem->init(_H.data(),_g.data(),
-                           Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>(_A).data(),
-                           _l.data(), _u.data(),
-                           _lA.data(),_uA.data(),
-                           nWSR,0,
-                           _solution.data(), _dual_solution.data(),
-                           _bounds.get(), _constraints.get());
+        start = Clock::now();
+        if(_sq_problem_b)
+            val = _sq_problem_b->init(copyHessian(),_g.data(),
+                               _l.data(), _u.data(),
+                               nWSR,0,
+                               _solution.data(), _dual_solution.data(),
+                               _bounds.get());
+        else
+            val = _sq_problem->init(copyHessian(),_g.data(),
+                               _A.data(),
+                               _l.data(), _u.data(),
+                               _lA.data(),_uA.data(),
+                               nWSR,0,
+                               _solution.data(), _dual_solution.data(),
+                               _bounds.get(), _constraints.get());
+        _stats.warmstart_time = elapsed(start);
 
         if(val != qpOASES::SUCCESSFUL_RETURN){
+            _is_initialised = false;
 #ifndef NDEBUG
             std::cout<<YELLOW<<"WARNING OPTIMIZING TASK IN WARMSTART! ERROR "<<val<<DEFAULT<<std::endl;
             std::cout<<GREEN<<"RETRYING INITING"<<DEFAULT<<std::endl;
 #endif
 
-            return initProblem(_H, _g, _A, _lA, _uA, _l ,_u);}
+            return initInternalProblem();}
+
+        ++_stats.warmstart_counter;
     }
+    else
+    {
+        ++_stats.hotstart_counter;
+        if(vectors_only)
+            ++_stats.vectors_hotstart_counter;
+    }
+    _is_H_changed = false;
+    _is_A_changed = false;
+    _qpoases_H_data = _H_regularised.data();
+    _qpoases_A_data = _A.data();
 
     // If solution has changed of size we update the size
     if(_solution.rows() != _problem->getNV())
         _solution.resize(_problem->getNV());
 
-    if(_dual_solution.rows() != _problem->getNV() + _problem->getNC())
-        _dual_solution.resize(_problem->getNV()+ _problem->getNC());
+    if(_dual_solution.rows() != _problem->getNV() + getProblemNC())
+        _dual_solution.resize(_problem->getNV() + getProblemNC());
 
     //We get the solution
     qpOASES::returnValue success = _problem->getPrimalSolution(_solution.data());
     _problem->getDualSolution(_dual_solution.data());
     _problem->getBounds(*_bounds);
-    _problem->getConstraints(*_constraints);
+    if(_sq_problem)
+        _sq_problem->getConstraints(*_constraints);
 
     if(success != qpOASES::SUCCESSFUL_RETURN){
 #ifndef NDEBUG
         std::cout<<"ERROR GETTING PRIMAL SOLUTION! ERROR "<<success<<std::endl;
 #endif
-        return initProblem(_H, _g, _A, _lA, _uA, _l ,_u);
+        return initInternalProblem();
     }
+
+    updateStats(nWSR);
     return true;
 }
 
+bool QPOasesProblem::solveClosedForm()
+{
+    const int nV = _g.rows();
+
+    // with H = I the problem is separable: each variable is the projection of -g_i onto [l_i, u_i]
+    if(_l.rows() == 0)
+        _solution = -_g;
+    else
+    {
+        if((_l.array() > _u.array()).any()){
+#ifndef NDEBUG
+            XBot::Logger::error("ERROR INCONSISTENT BOUNDS IN CLOSED FORM SOLUTION \n");
+#endif
+            return false;}
+
+        _solution = (-_g).cwiseMax(_l).cwiseMin(_u);
+    }
+
+    // as in qpOASES y = Hx + g: positive on the lower bounds, negative on the upper ones
+    _dual_solution = _solution + _g;
+
+    _bounds->init(nV);
+    for(int i = 0; i < nV; ++i)
+    {
+        if(_dual_solution[i] > 0.)
+            _bounds->setupBound(i, qpOASES::ST_LOWER);
+        else if(_dual_solution[i] < 0.)
+            _bounds->setupBound(i, qpOASES::ST_UPPER);
+        else
+            _bounds->setupBound(i, qpOASES::ST_INACTIVE);
+    }
+
+    updateStats(0);
+    return true;
+}
+
+bool QPOasesProblem::solveDirectKKT()
+{
+    const int nV = _H.cols();
+    const int nC = _number_of_constraints;
+
+    // the equality constraints are the only active ones
+    if(_kkt_rows.size() < nC)
+        _kkt_rows.resize(nC);
+    int nE = 0;
+    for(int i = 0; i < nC; ++i)
+    {
+        if(_lA[i] == _uA[i])
+            _kkt_rows[nE++] = i;
+    }
+
+    // the Hessian is regularised as qpOASES does, then the regularisation is removed by the
+    // successive steps with gradient g - reg*x
+    const qpOASES::Options options = _problem->getOptions();
+    double regularisation = 0.;
+    int steps = 0;
+    if(_problem->usingRegularisation())
+    {
+        regularisation = _H.norm()*options.epsRegularisation;
+        steps = options.numRegularisationSteps;
+    }
+
+    _kkt_H = _H;
+    _kkt_H.diagonal().array() += regularisation;
+    _kkt_llt.compute(_kkt_H);
+    if(_kkt_llt.info() != Eigen::Success)
+        return false;
+
+    if(nE > 0)
+    {
+        if(_kkt_E.rows() != nE || _kkt_E.cols() != nV)
+        {
+            _kkt_E.resize(nE, nV);
+            _kkt_e.resize(nE);
+        }
+        for(int k = 0; k < nE; ++k)
+        {
+            _kkt_E.row(k) = _A.row(_kkt_rows[k]);
+            _kkt_e[k] = _lA[_kkt_rows[k]];
+        }
+
+        _kkt_HiEt = _kkt_E.transpose();
+        _kkt_llt.solveInPlace(_kkt_HiEt);
+        _kkt_S.noalias() = _kkt_E*_kkt_HiEt;
+        _kkt_ldlt.compute(_kkt_S);
+    }
+
+    for(int step = 0; step <= steps; ++step)
+    {
+        if(step == 0)
+            _kkt_q = _g;
+        else
+            _kkt_q = _g - regularisation*_kkt_x;
+
+        // x = -H^-1(q + E'lambda), with lambda such that Ex = e
+        _kkt_x = -_kkt_q;
+        _kkt_llt.solveInPlace(_kkt_x);
+        if(nE > 0)
+        {
+            _kkt_r.noalias() = _kkt_E*_kkt_x;
+            _kkt_r -= _kkt_e;
+            _kkt_lambda = _kkt_ldlt.solve(_kkt_r);
+            _kkt_x.noalias() -= _kkt_HiEt*_kkt_lambda;
+        }
+    }
+
+    // the solution is accepted only if it satisfies all the constraints (the equalities are
+    // checked too, in case the Schur complement is singular) and the bounds
+    _kkt_Ax.noalias() = _A.topRows(nC)*_kkt_x;
+    for(int i = 0; i < nC; ++i)
+    {
+        if(_kkt_Ax[i] < _lA[i] - _direct_kkt_tolerance || _kkt_Ax[i] > _uA[i] + _direct_kkt_tolerance)
+            return false;
+    }
+    for(int i = 0; i < _l.rows(); ++i)
+    {
+        if(_kkt_x[i] < _l[i] - _direct_kkt_tolerance || _kkt_x[i] > _u[i] + _direct_kkt_tolerance)
+            return false;
+    }
+
+    _solution = _kkt_x;
+
+    // as in qpOASES Hx + g = A'y + y_bounds: only the equality constraints have multipliers
+    const int nC_problem = getProblemNC();
+    if(_dual_solution.rows() != nV + nC_problem)
+        _dual_solution.resize(nV + nC_problem);
+    _dual_solution.setZero();
+    for(int k = 0; k < nE; ++k)
+        _dual_solution[nV + _kkt_rows[k]] = -_kkt_lambda[k];
+
+    _bounds->init(nV);
+    for(int i = 0; i < nV; ++i)
+        _bounds->setupBound(i, qpOASES::ST_INACTIVE);
+
+    _constraints->init(nC_problem);
+    for(int i = 0, k = 0; i < nC_problem; ++i)
+    {
+        if(k < nE && _kkt_rows[k] == i)
+        {
+            _constraints->setupConstraint(i, qpOASES::ST_LOWER);
+            ++k;
+        }
+        else
+            _constraints->setupConstraint(i, qpOASES::ST_INACTIVE);
+    }
+
+    updateStats(0);
+    return true;
+}
 
 OpenSoT::HessianType QPOasesProblem::getHessianType() {return (OpenSoT::HessianType)(_problem->getHessianType());}
 
@@ -316,8 +824,11 @@ void QPOasesProblem::setHessianType(const OpenSoT::HessianType ht){_problem->set
 
 void QPOasesProblem::checkInfeasibility()
 {
+    if(!_sq_problem)
+        return;
+
     qpOASES::Constraints infeasibleConstraints;
-    _problem->getConstraints(infeasibleConstraints);
+    _sq_problem->getConstraints(infeasibleConstraints);
     std::cout<<RED<<"Constraints:"<<DEFAULT<<std::endl;
     infeasibleConstraints.print();
 
@@ -341,10 +852,14 @@ void QPOasesProblem::printProblemInformation(const int problem_number, const std
         std::cout<<GREEN<<"PROBLEM "<<problem_number<<" ID: "<<DEFAULT<<problem_id<<std::endl;
     std::cout<<GREEN<<"eps Regularisation factor: "<<DEFAULT<<_problem->getOptions().epsRegularisation<<std::endl;
     std::cout<<GREEN<<"CONSTRAINTS ID: "<<DEFAULT<<constraints_id<<std::endl;
-    std::cout<<GREEN<<"     # OF CONSTRAINTS: "<<DEFAULT<<_problem->getNC()<<std::endl;
+    std::cout<<GREEN<<"     # OF CONSTRAINTS: "<<DEFAULT<<getProblemNC()<<std::endl;
     std::cout<<GREEN<<"BOUNDS ID: "<<DEFAULT<<bounds_id<<std::endl;
     std::cout<<GREEN<<"     # OF BOUNDS: "<<DEFAULT<<_l.rows()<<std::endl;
     std::cout<<GREEN<<"# OF VARIABLES: "<<DEFAULT<<_problem->getNV()<<std::endl;
+    if(isClosedForm())
+        std::cout<<GREEN<<"BOUNDS ONLY: "<<DEFAULT<<"solved in closed form"<<std::endl;
+    else if(isBoundsOnly())
+        std::cout<<GREEN<<"BOUNDS ONLY: "<<DEFAULT<<"solved by SQProblemB"<<std::endl;
     std::cout<<std::endl;
 }
 
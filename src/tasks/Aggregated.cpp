@@ -93,22 +93,112 @@ void Aggregated::checkSizes() {
 
 
 void Aggregated::generateAll() {
-    _tmpA.reset(_x_size);
-    _tmpb.reset(1);
+    // A is piled again only if the A or the weight of some task changed since
+    // the last time, or if it has been zeroed by a mask or by the task being inactive
+    bool is_A_changed = !this->isActive() || _is_A_masked ||
+                        _tasks_A_generation.size() != _tasks.size();
+    if(_tasks_A_generation.size() != _tasks.size())
+    {
+        _tasks_A_generation.resize(_tasks.size());
+        _tasks_W_generation.resize(_tasks.size());
+    }
 
+    int rows = 0;
+    unsigned int k = 0;
+    for(std::list< TaskPtr >::iterator i = _tasks.begin();
+        i != _tasks.end(); ++i, ++k) {
+        TaskPtr t = *i;
+        rows += t->getA().rows();
+        if(t->getAGeneration() != _tasks_A_generation[k] ||
+           t->getWeightGeneration() != _tasks_W_generation[k])
+        {
+            is_A_changed = true;
+            _tasks_A_generation[k] = t->getAGeneration();
+            _tasks_W_generation[k] = t->getWeightGeneration();
+        }
+    }
+
+    if(_A.rows() != rows || _A.cols() != _x_size)
+    {
+        _A.resize(rows, _x_size);
+        is_A_changed = true;
+    }
+    if(_b.size() != rows)
+        _b.resize(rows);
+
+    // W_k*A_k and W_k*b_k are written directly in their rows: the product is
+    // computed only when the weight of the task is a full matrix
+    rows = 0;
     for(std::list< TaskPtr >::iterator i = _tasks.begin();
         i != _tasks.end(); ++i) {
         TaskPtr t = *i;
-        _tmpA.pile(t->getWeight()*t->getA());
-        _tmpb.pile(t->getWeight()*t->getb());
+        const Eigen::MatrixXd& W = t->getWeight();
+        const int task_rows = t->getA().rows();
+        const WeightType weight_type = t->getWeightType();
+        if(weight_type == WT_IDENTITY)
+        {
+            if(is_A_changed)
+                _A.middleRows(rows, task_rows) = t->getA();
+            _b.segment(rows, task_rows) = t->getb();
+        }
+        else if(weight_type == WT_DIAGONAL)
+        {
+            if(is_A_changed)
+                _A.middleRows(rows, task_rows).noalias() = W.diagonal().asDiagonal()*t->getA();
+            _b.segment(rows, task_rows).noalias() = W.diagonal().asDiagonal()*t->getb();
+        }
+        else
+        {
+            if(is_A_changed)
+                _A.middleRows(rows, task_rows).noalias() = W*t->getA();
+            _b.segment(rows, task_rows).noalias() = W*t->getb();
+        }
+        rows += task_rows;
     }
 
-    _A = _tmpA.generate_and_get();
-    _b = _tmpb.generate_and_get();
+    if(is_A_changed)
+        generateJacobianType();
+    else
+        _is_A_changed = false;
 
     generateConstraints();
 }
 
+void Aggregated::generateJacobianType()
+{
+    // rows of the identity piled with an identity weight are a selection
+    _jacobianSelection.clear();
+    for(std::list< TaskPtr >::iterator i = _tasks.begin();
+        i != _tasks.end(); ++i) {
+        TaskPtr t = *i;
+        if(t->getWeightType() != WT_IDENTITY)
+        {
+            _jacobianType = JT_DENSE;
+            return;
+        }
+
+        if(t->getJacobianType() == JT_IDENTITY)
+        {
+            for(unsigned int j = 0; j < t->getXSize(); ++j)
+                _jacobianSelection.push_back(j);
+        }
+        else if(t->getJacobianType() == JT_SELECTION)
+            _jacobianSelection.insert(_jacobianSelection.end(),
+                                      t->getJacobianSelection().begin(),
+                                      t->getJacobianSelection().end());
+        else
+        {
+            _jacobianType = JT_DENSE;
+            return;
+        }
+    }
+
+    if(_tasks.size() == 1 && _tasks.front()->getJacobianType() == JT_IDENTITY)
+        _jacobianType = JT_IDENTITY;
+    else
+        _jacobianType = JT_SELECTION;
+}
+
 void OpenSoT::tasks::Aggregated::generateConstraints()
 {
     int constraintsSize = this->_constraints.size();
@@ -11,9 +11,13 @@ OpenSoT::SubTask::SubTask(OpenSoT::SubTask::TaskPtr taskPtr, const std::list<uns
     this->_W.resize(rowIndices.size(), rowIndices.size());
 
     this->generateA();
+    this->generateJacobianType();
     this->generateb();
     this->generateHessianAtype();
     this->generateWeight();
+
+    _father_A_generation = _taskPtr->getAGeneration();
+    _father_W_generation = _taskPtr->getWeightGeneration();
 }
 
 void OpenSoT::SubTask::generateA()
@@ -29,6 +33,27 @@ void OpenSoT::SubTask::generateA()
     }
 }
 
+void OpenSoT::SubTask::generateJacobianType()
+{
+    // the rows taken from an identity, or from a selection, are a selection
+    const std::vector<unsigned int>& indices = this->_subTaskMap.asVector();
+    switch(_taskPtr->getJacobianType())
+    {
+    case JT_IDENTITY:
+        this->_jacobianSelection = indices;
+        this->_jacobianType = JT_SELECTION;
+        break;
+    case JT_SELECTION:
+        this->_jacobianSelection.resize(indices.size());
+        for(unsigned int r = 0; r < indices.size(); ++r)
+            this->_jacobianSelection[r] = _taskPtr->getJacobianSelection()[indices[r]];
+        this->_jacobianType = JT_SELECTION;
+        break;
+    default:
+        this->_jacobianType = JT_DENSE;
+    }
+}
+
 void OpenSoT::SubTask::generateHessianAtype()
 {
     OpenSoT::HessianType fatherHessianType = _taskPtr->getHessianAtype();
@@ -57,12 +82,36 @@ void OpenSoT::SubTask::generateb()
 
 void OpenSoT::SubTask::generateWeight()
 {
+    // an identity weight is written only once, and of a diagonal weight only the
+    // diagonal is copied: the element-wise copy is needed only for a generic weight
+    const std::vector<unsigned int>& indices = this->_subTaskMap.asVector();
+    const unsigned int size = this->getTaskSize();
+    switch(_taskPtr->getWeightType())
+    {
+    case WT_IDENTITY:
+        if(this->_weightType != WT_IDENTITY)
+        {
+            this->_W.setIdentity(_W.rows(), _W.cols());
+            this->_weightType = WT_IDENTITY;
+        }
+        break;
+    case WT_DIAGONAL:
+        if(this->_weightType != WT_DIAGONAL)
+        {
+            this->_W.setZero(_W.rows(), _W.cols());
+            this->_weightType = WT_DIAGONAL;
+        }
+        for(unsigned int r = 0; r < size; ++r)
+            this->_W(r,r) = _taskPtr->getWeight()(indices[r], indices[r]);
+        break;
+    default:
         this->_W.setZero(_W.rows(), _W.cols());
 
-        for(unsigned int r = 0; r < this->getTaskSize(); ++r)
-            for(unsigned int c = 0; c < this->getTaskSize(); ++c)
-                this->_W(r,c) = _taskPtr->getWeight()(this->_subTaskMap.asVector()[r],
-                                                      this->_subTaskMap.asVector()[c]);
+        for(unsigned int r = 0; r < size; ++r)
+            for(unsigned int c = 0; c < size; ++c)
+                this->_W(r,c) = _taskPtr->getWeight()(indices[r], indices[c]);
+        this->_weightType = WT_DENSE;
+    }
 }
 
 void OpenSoT::SubTask::setWeight(const Eigen::MatrixXd &W)
@@ -71,6 +120,8 @@ void OpenSoT::SubTask::setWeight(const Eigen::MatrixXd &W)
     assert(W.cols() == W.rows());
 
     this->_W = W;
+    this->_weightType = computeWeightType(_W);
+    ++_W_generation;
     Eigen::MatrixXd fullW = _taskPtr->getWeight();
     for(unsigned int r = 0; r < this->getTaskSize(); ++r)
         for(unsigned int c = 0; c < this->getTaskSize(); ++c)
@@ -103,10 +154,28 @@ const unsigned int OpenSoT::SubTask::getTaskSize() const
 void OpenSoT::SubTask::_update(const Eigen::VectorXd &x)
 {
     _taskPtr->update(x);
-    this->generateA();
+
+    // A is generated again only if it changed in the father task, or if it has been
+    // zeroed by a mask or by the task being inactive
+    if(_taskPtr->getAGeneration() != _father_A_generation ||
+       !this->isActive() || this->_is_A_masked)
+    {
+        this->generateA();
+        this->generateJacobianType();
+        _father_A_generation = _taskPtr->getAGeneration();
+    }
+    else
+        _is_A_changed = false;
+
     this->generateb();
     this->generateHessianAtype();
-    this->generateWeight();
+
+    if(_taskPtr->getWeightGeneration() != _father_W_generation)
+    {
+        this->generateWeight();
+        _father_W_generation = _taskPtr->getWeightGeneration();
+        ++_W_generation;
+    }
 }
 
 std::vector<bool> OpenSoT::SubTask::getActiveJointsMask()
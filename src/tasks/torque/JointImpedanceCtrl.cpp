@@ -65,9 +65,12 @@ void JointImpedanceCtrl::_update(const Eigen::VectorXd &x) {
 
     _W.setIdentity(_W.rows(), _W.cols());
     _hessianType = HST_IDENTITY;
+    _weightType = WT_IDENTITY;
+    ++_W_generation;
     if(_use_inertia_matrix)
     {
         _hessianType = HST_POSDEF;
+        _weightType = WT_DENSE;
 
         _robot.getInertiaInverse(_W);
     }
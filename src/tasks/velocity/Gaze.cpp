@@ -93,6 +93,8 @@ void Gaze::setWeight(const Eigen::MatrixXd &W)
 {
     this->_W = W;
     _subtask->setWeight(W);
+    this->_weightType = _subtask->getWeightType();
+    ++this->_W_generation;
 }
 
 std::list<OpenSoT::SubTask::ConstraintPtr> &Gaze::getConstraints()
@@ -112,6 +114,8 @@ void Gaze::_update(const Eigen::VectorXd &x)
     this->_b = _subtask->getb();
     this->_hessianType = _subtask->getHessianAtype();
     this->_W = _subtask->getWeight();
+    this->_weightType = _subtask->getWeightType();
+    ++this->_W_generation;
 }
 
 std::vector<bool> Gaze::getActiveJointsMask()
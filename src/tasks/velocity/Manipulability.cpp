@@ -17,6 +17,7 @@ Manipulability::Manipulability(const Eigen::VectorXd& x, const XBot::ModelInterf
 
     _A.resize(_x_size, _x_size);
     _A.setIdentity(_x_size, _x_size);
+    _jacobianType = JT_IDENTITY;
 
     /* first update. Setting desired pose equal to the actual pose */
     this->_update(x);
@@ -36,6 +37,7 @@ Manipulability::Manipulability(const Eigen::VectorXd& x, const XBot::ModelInterf
 
     _A.resize(_x_size, _x_size);
     _A.setIdentity(_x_size, _x_size);
+    _jacobianType = JT_IDENTITY;
 
 
     /* first update. Setting desired pose equal to the actual pose */
@@ -54,6 +56,9 @@ void Manipulability::_update(const Eigen::VectorXd &x) {
 
     _b = _lambda*cartesian_utils::computeGradient(x, _manipulabilityIndexGradientWorker, this->getActiveJointsMask());
 
+    // A is the identity set by the constructor
+    _is_A_changed = false;
+
     /**********************************************************************/
 }
 
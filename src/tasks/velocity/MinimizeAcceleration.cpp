@@ -15,6 +15,7 @@ MinimizeAcceleration::MinimizeAcceleration(const Eigen::VectorXd &x):
 
     _A.resize(_x_size, _x_size);
     _A.setIdentity(_x_size, _x_size);
+    _jacobianType = JT_IDENTITY;
 
     _hessianType = HST_IDENTITY;
 
@@ -29,6 +30,9 @@ MinimizeAcceleration::~MinimizeAcceleration()
 void MinimizeAcceleration::_update(const Eigen::VectorXd &x) {
     _b = x - _x_before;
     _x_before = x;
+
+    // A is the identity set by the constructor
+    _is_A_changed = false;
 }
 
 void MinimizeAcceleration::setLambda(double lambda){
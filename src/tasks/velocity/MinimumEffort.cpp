@@ -32,6 +32,7 @@ MinimumEffort::MinimumEffort(   const Eigen::VectorXd& x, const XBot::ModelInter
 
     _A.resize(_x_size, _x_size);
     _A.setIdentity(_x_size, _x_size);
+    _jacobianType = JT_IDENTITY;
 
     /* first update. Setting desired pose equal to the actual pose */
     this->_update(x);
@@ -49,6 +50,9 @@ void MinimumEffort::_update(const Eigen::VectorXd &x) {
 
     _b = -1.0 * _lambda * cartesian_utils::computeGradient(x, _gTauGradientWorker, this->getActiveJointsMask());
 
+    // A is the identity set by the constructor
+    _is_A_changed = false;
+
     /**********************************************************************/
 }
 
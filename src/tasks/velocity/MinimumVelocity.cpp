@@ -29,6 +29,7 @@ MinimumVelocity::MinimumVelocity(const int& x_size) :
 
     _A.resize(_x_size, _x_size);
     _A.setIdentity(_x_size, _x_size);
+    _jacobianType = JT_IDENTITY;
 
     _b.resize(_x_size);
     _b.setZero(_x_size);
@@ -42,6 +43,8 @@ MinimumVelocity::~MinimumVelocity()
 
 void MinimumVelocity::_update(const Eigen::VectorXd &x)
 {
+    // A is the identity set by the constructor
+    _is_A_changed = false;
 }
 
 // TODO setWeight should not really change the weight - and same getWeight
@@ -31,6 +31,7 @@ Postural::Postural(   const Eigen::VectorXd& x) :
 
     _W.setIdentity(_x_size, _x_size);
     _A.setIdentity(_x_size, _x_size);
+    _jacobianType = JT_IDENTITY;
 
     _hessianType = HST_IDENTITY;
 
@@ -52,6 +53,9 @@ void Postural::_update(const Eigen::VectorXd &x) {
 
     _xdot_desired.setZero(_x_size);
 
+    // A is the identity set by the constructor
+    _is_A_changed = false;
+
     /**********************************************************************/
 }
 
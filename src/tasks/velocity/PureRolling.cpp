@@ -84,6 +84,8 @@ void OpenSoT::tasks::velocity::PureRollingPosition::_update(const Eigen::VectorX
     _A = _subtask->getA();
     _b = _subtask->getb();
 	_W = _subtask->getWeight();
+	_weightType = _subtask->getWeightType();
+	++_W_generation;
 }
 
 OpenSoT::tasks::velocity::PureRollingOrientation::PureRollingOrientation(std::string wheel_link_name,
@@ -109,4 +111,6 @@ void OpenSoT::tasks::velocity::PureRollingOrientation::_update(const Eigen::Vect
     _A = _subtask->getA();
     _b = _subtask->getb();
 	_W = _subtask->getWeight();
+	_weightType = _subtask->getWeightType();
+	++_W_generation;
 }
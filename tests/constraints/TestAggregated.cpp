@@ -254,6 +254,39 @@ TEST_F(testAggregated, MultipleAggregationdWork) {
 }
 
 
+TEST_F(testAggregated, testGenerations) {
+    using namespace OpenSoT::constraints;
+    const unsigned int nJ = 6;
+    Eigen::VectorXd q(nJ); q.setZero(nJ);
+
+    Eigen::MatrixXd C(2, nJ);
+    C.setRandom(2, nJ);
+    std::list<Aggregated::ConstraintPtr> constraints;
+    constraints.push_back(Aggregated::ConstraintPtr(
+        new velocity::VelocityLimits(0.3, 0.1, nJ)));
+    constraints.push_back(Aggregated::ConstraintPtr(
+        new BilateralConstraint(C, -Eigen::VectorXd::Ones(2), Eigen::VectorXd::Ones(2))));
+
+    Aggregated aggregated(constraints, q);
+    EXPECT_TRUE(aggregated.tracksGenerations());
+
+    // the constraint matrices are piled again only when they change
+    const unsigned int A_generation = aggregated.getAGeneration();
+    q.setConstant(0.1);
+    aggregated.update(q);
+    EXPECT_EQ(aggregated.getAGeneration(), A_generation);
+    EXPECT_TRUE(aggregated.getAineq() == C);
+
+    Eigen::MatrixXd C2(1, nJ);
+    C2.setRandom(1, nJ);
+    aggregated.getConstraintsList().back().reset(
+        new BilateralConstraint(C2, -Eigen::VectorXd::Ones(1), Eigen::VectorXd::Ones(1)));
+    aggregated.update(q);
+    EXPECT_NE(aggregated.getAGeneration(), A_generation);
+    EXPECT_TRUE(aggregated.getAineq() == C2);
+    EXPECT_EQ(aggregated.getbUpperBound().size(), 1);
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
@@ -14,6 +14,8 @@
 #include <fstream>
 #include <OpenSoT/solvers/QPOases.h>
 #include <OpenSoT/tasks/velocity/MinimumEffort.h>
+#include <OpenSoT/constraints/BilateralConstraint.h>
+#include <OpenSoT/SubTask.h>
 #include <XBotInterface/ModelInterface.h>
 
 
@@ -175,9 +177,79 @@ class testQPOases_sot: public ::testing::Test
 protected:
     std::ofstream _log;
 
-    testQPOases_sot()
+    unsigned int _n_dofs;
+    Eigen::VectorXd _q;
+    OpenSoT::solvers::QPOases_sot::Stack _stack_of_tasks;
+    OpenSoT::constraints::velocity::VelocityLimits::Ptr _joint_vel_limits;
+    std::list<OpenSoT::Constraint<Eigen::MatrixXd, Eigen::VectorXd>::ConstraintPtr> _constraints;
+    std::vector<Eigen::VectorXd> _dq;
+
+    testQPOases_sot():
+        _n_dofs(8)
     {
         _log.open("testQPOases_sot.m");
+
+        _q.setZero(_n_dofs);
+        _joint_vel_limits.reset(new OpenSoT::constraints::velocity::VelocityLimits(0.3, 0.1, _n_dofs));
+    }
+
+    /**
+     * @brief createStack fills _stack_of_tasks with postural tasks: the joints in indices1 are
+     * brought to 1, the ones in indices2 (if any) to -1 and the last task spans all the joints
+     * with a reference from -2 to 2
+     */
+    void createStack(const std::list<unsigned int>& indices1,
+                     const std::list<unsigned int>& indices2 = std::list<unsigned int>())
+    {
+        OpenSoT::tasks::velocity::Postural::Ptr postural_task1(
+                new OpenSoT::tasks::velocity::Postural(_q));
+        postural_task1->setReference(Eigen::VectorXd::Constant(_n_dofs, 1.));
+        _stack_of_tasks.push_back(OpenSoT::SubTask::Ptr(new OpenSoT::SubTask(postural_task1, indices1)));
+
+        if(!indices2.empty())
+        {
+            OpenSoT::tasks::velocity::Postural::Ptr postural_task2(
+                    new OpenSoT::tasks::velocity::Postural(_q));
+            postural_task2->setReference(Eigen::VectorXd::Constant(_n_dofs, -1.));
+            _stack_of_tasks.push_back(OpenSoT::SubTask::Ptr(new OpenSoT::SubTask(postural_task2, indices2)));
+        }
+
+        OpenSoT::tasks::velocity::Postural::Ptr postural_task3(
+                new OpenSoT::tasks::velocity::Postural(_q));
+        postural_task3->setReference(Eigen::VectorXd::LinSpaced(_n_dofs, -2., 2.));
+        _stack_of_tasks.push_back(postural_task3);
+    }
+
+    /**
+     * @brief solve updates the stack, the joint velocity limits and _constraints in _q, then
+     * solves with every solver and checks that the solutions in _dq match the one of the first
+     * solver, which is integrated in _q
+     * @return false if a solver fails
+     */
+    bool solve(const std::vector<OpenSoT::solvers::QPOases_sot*>& solvers, const double tolerance = 1E-6)
+    {
+        for(unsigned int j = 0; j < _stack_of_tasks.size(); ++j)
+            _stack_of_tasks[j]->update(_q);
+        _joint_vel_limits->update(_q);
+        for(std::list<OpenSoT::Constraint<Eigen::MatrixXd, Eigen::VectorXd>::ConstraintPtr>::iterator constraint = _constraints.begin();
+            constraint != _constraints.end(); ++constraint)
+            (*constraint)->update(_q);
+
+        _dq.resize(solvers.size(), Eigen::VectorXd::Zero(_n_dofs));
+        for(unsigned int k = 0; k < solvers.size(); ++k)
+        {
+            if(!solvers[k]->solve(_dq[k]))
+                return false;
+        }
+
+        for(unsigned int k = 1; k < solvers.size(); ++k)
+        {
+            for(unsigned int j = 0; j < _n_dofs; ++j)
+                EXPECT_NEAR(_dq[0][j], _dq[k][j], tolerance);
+        }
+
+        _q += _dq[0];
+        return true;
     }
 
     virtual ~testQPOases_sot() {
@@ -276,6 +348,381 @@ TEST_F(testQPOasesProblem, test_update_constraint)
 //    EXPECT_NEAR(solution[2], 2.5714,1E-4);
 }
 
+TEST_F(testQPOasesProblem, test_constraints_capacity)
+{
+    OpenSoT::solvers::QPOasesProblem qp(3,0);
+    EXPECT_TRUE(qp.setConstraintsCapacity(2));
+    EXPECT_EQ(qp.getConstraintsCapacity(), 2);
+
+    Eigen::MatrixXd H(1,3);
+    H<<1,1,1;
+    Eigen::VectorXd b(1);
+    b<<10;
+    Eigen::MatrixXd A(0,3);
+    Eigen::VectorXd lA(0);
+    Eigen::VectorXd uA(0);
+    Eigen::VectorXd l(3);
+    l<<-10,
+       -10,
+       -10;
+    Eigen::VectorXd u(3);
+    u<<10,
+       10,
+       10;
+    EXPECT_TRUE(qp.initProblem(H.transpose()*H,-1.*H.transpose()*b,A,lA,uA,l,u));
+    EXPECT_EQ(qp.getNumberOfConstraints(), 0);
+    EXPECT_EQ(qp.getA().rows(), 0);
+    EXPECT_EQ(qp.getStats().init_counter, 1u);
+    EXPECT_EQ(qp.getStats().nV, 3);
+    EXPECT_EQ(qp.getStats().nC, 2);
+    EXPECT_GT(qp.getStats().memory, 0ul);
+
+    qpOASES::QProblemB* problem = qp.getProblem().get();
+
+    EXPECT_TRUE(qp.solve());
+    Eigen::VectorXd solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 3.333,1E-3);
+    EXPECT_NEAR(solution[1], 3.333,1E-3);
+    EXPECT_NEAR(solution[2], 3.333,1E-3);
+
+    //adding a constraint does not re-create the problem
+    A.resize(1,3);
+    A<<1,0,1;
+    lA.resize(1);
+    lA<<20;
+    uA=lA;
+    EXPECT_TRUE(qp.updateConstraints(A, lA,uA));
+    EXPECT_EQ(qp.getNumberOfConstraints(), 1);
+    EXPECT_TRUE(qp.getA() == A);
+    EXPECT_TRUE(qp.solve());
+    EXPECT_EQ(qp.getProblem().get(), problem);
+    EXPECT_EQ(qp.getStats().init_counter, 1u);
+    EXPECT_EQ(qp.getStats().hotstart_counter, 2u);
+    EXPECT_EQ(qp.getStats().active_constraints, 1);
+    solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 10.,1E-6);
+    EXPECT_NEAR(solution[1],-10.,1E-6);
+    EXPECT_NEAR(solution[2], 10.,1E-6);
+
+    //removing it neither, the unused row is inert
+    A.resize(0,3);
+    lA.resize(0);
+    uA.resize(0);
+    EXPECT_TRUE(qp.updateConstraints(A, lA,uA));
+    EXPECT_EQ(qp.getNumberOfConstraints(), 0);
+    EXPECT_TRUE(qp.solve());
+    EXPECT_EQ(qp.getProblem().get(), problem);
+    solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 3.333,1E-3);
+    EXPECT_NEAR(solution[1], 3.333,1E-3);
+    EXPECT_NEAR(solution[2], 3.333,1E-3);
+
+    //exceeding the capacity grows it
+    A.resize(3,3);
+    A<<1,0,1,
+       0,1,0,
+       1,0,0;
+    lA.resize(3);
+    lA<<20,-10,-10;
+    uA.resize(3);
+    uA<<20,-10,10;
+    EXPECT_TRUE(qp.updateConstraints(A, lA,uA));
+    EXPECT_EQ(qp.getConstraintsCapacity(), 3);
+    EXPECT_EQ(qp.getNumberOfConstraints(), 3);
+    EXPECT_TRUE(qp.solve());
+    EXPECT_EQ(qp.getStats().init_counter, 2u);
+    EXPECT_GT(qp.getStats().init_time, 0.);
+    solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 10.,1E-6);
+    EXPECT_NEAR(solution[1],-10.,1E-6);
+    EXPECT_NEAR(solution[2], 10.,1E-6);
+
+    EXPECT_FALSE(qp.setConstraintsCapacity(2));
+}
+
+TEST_F(testQPOasesProblem, test_bounds_only)
+{
+    OpenSoT::solvers::QPOasesProblem qp(3,0);
+    EXPECT_TRUE(qp.isBoundsOnly());
+
+    Eigen::MatrixXd H(3,3);
+    H.setIdentity(3,3);
+    Eigen::VectorXd b(3);
+    b<<1,
+      -3,
+       4;
+    Eigen::MatrixXd A(0,3);
+    Eigen::VectorXd lA(0);
+    Eigen::VectorXd uA(0);
+    Eigen::VectorXd l(3);
+    l<<-10,
+       -10,
+        0;
+    Eigen::VectorXd u(3);
+    u<<10,
+       10,
+        2;
+    EXPECT_TRUE(qp.initProblem(H.transpose()*H,-1.*H.transpose()*b,A,lA,uA,l,u));
+    EXPECT_TRUE(qp.isBoundsOnly());
+    EXPECT_EQ(qp.getStats().nC, 0);
+
+    EXPECT_TRUE(qp.solve());
+    Eigen::VectorXd solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 1.,1E-6);
+    EXPECT_NEAR(solution[1],-3.,1E-6);
+    EXPECT_NEAR(solution[2], 2.,1E-6);
+
+    //the Hessian changes in the hotstart
+    H.diagonal()<<1,2,1;
+    b<<6,
+       4,
+      -1;
+    EXPECT_TRUE(qp.updateTask(H.transpose()*H, -1.*H.transpose()*b));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_TRUE(qp.isBoundsOnly());
+    solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 6.,1E-6);
+    EXPECT_NEAR(solution[1], 2.,1E-6);
+    EXPECT_NEAR(solution[2], 0.,1E-6);
+
+    //a constraint switches to the general problem
+    A.resize(1,3);
+    A<<1,0,1;
+    lA.resize(1);
+    lA<<-1;
+    uA=lA;
+    EXPECT_TRUE(qp.updateConstraints(A, lA,uA));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_FALSE(qp.isBoundsOnly());
+    solution = qp.getSolution();
+    EXPECT_NEAR(solution[0],-1.,1E-6);
+    EXPECT_NEAR(solution[1], 2.,1E-6);
+    EXPECT_NEAR(solution[2], 0.,1E-6);
+
+    //and removing it switches back
+    A.resize(0,3);
+    lA.resize(0);
+    uA.resize(0);
+    EXPECT_TRUE(qp.updateConstraints(A, lA,uA));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_TRUE(qp.isBoundsOnly());
+    solution = qp.getSolution();
+    EXPECT_NEAR(solution[0], 6.,1E-6);
+    EXPECT_NEAR(solution[1], 2.,1E-6);
+    EXPECT_NEAR(solution[2], 0.,1E-6);
+}
+
+TEST_F(testQPOasesProblem, test_closed_form)
+{
+    OpenSoT::solvers::QPOasesProblem qp(3,0,OpenSoT::HST_IDENTITY);
+    //the same problem with a constraint is solved by qpOASES
+    OpenSoT::solvers::QPOasesProblem qp_constrained(3,1,OpenSoT::HST_IDENTITY);
+
+    Eigen::MatrixXd H(3,3);
+    H.setIdentity(3,3);
+    Eigen::VectorXd g(3);
+    g<<-1,
+        3,
+       -4;
+    Eigen::MatrixXd A(0,3);
+    Eigen::VectorXd lA(0);
+    Eigen::VectorXd uA(0);
+    Eigen::MatrixXd A_inert(1,3);
+    A_inert<<1,1,1;
+    Eigen::VectorXd lA_inert(1);
+    lA_inert<<-100;
+    Eigen::VectorXd uA_inert(1);
+    uA_inert<<100;
+    Eigen::VectorXd l(3);
+    l<<-10,
+       -10,
+        0;
+    Eigen::VectorXd u(3);
+    u<<10,
+       10,
+        2;
+    EXPECT_TRUE(qp.initProblem(H,g,A,lA,uA,l,u));
+    EXPECT_TRUE(qp_constrained.initProblem(H,g,A_inert,lA_inert,uA_inert,l,u));
+    EXPECT_TRUE(qp.isClosedForm());
+    EXPECT_FALSE(qp_constrained.isClosedForm());
+
+    for(unsigned int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(qp.updateTask(g));
+        EXPECT_TRUE(qp_constrained.updateTask(H,g));
+        EXPECT_TRUE(qp.solve());
+        EXPECT_TRUE(qp_constrained.solve());
+
+        Eigen::VectorXd solution = qp.getSolution();
+        EXPECT_NEAR(solution[0], std::min(std::max(-g[0],l[0]),u[0]),1E-12);
+        EXPECT_NEAR(solution[1], std::min(std::max(-g[1],l[1]),u[1]),1E-12);
+        EXPECT_NEAR(solution[2], std::min(std::max(-g[2],l[2]),u[2]),1E-12);
+        EXPECT_TRUE(solution.isApprox(qp_constrained.getSolution(), 1E-9));
+        EXPECT_EQ(qp.getStats().active_bounds, qp_constrained.getStats().active_bounds);
+        EXPECT_EQ(qp.getActiveBounds().getStatus(2), qp_constrained.getActiveBounds().getStatus(2));
+
+        g<<-20,
+            1,
+            1;
+    }
+    //the initialisation and the 3 solutions
+    EXPECT_EQ(qp.getStats().closed_form_counter, 4u);
+    EXPECT_EQ(qp.getStats().hotstart_counter, 0u);
+    EXPECT_EQ(qp.getStats().init_counter, 0u);
+    EXPECT_EQ(qp.getStats().nWSR, 0);
+
+    //a Hessian which is not the identity goes back to qpOASES: since it was never
+    //initialised, it is initialised instead of failing the hotstart and the warmstart
+    H(1,1) = 2.;
+    EXPECT_TRUE(qp.updateTask(H,g));
+    EXPECT_FALSE(qp.isClosedForm());
+    EXPECT_TRUE(qp.solve());
+    EXPECT_NEAR(qp.getSolution()[1], -0.5,1E-6);
+    EXPECT_EQ(qp.getStats().warmstart_counter, 0u);
+    EXPECT_EQ(qp.getStats().init_counter, 1u);
+
+    //and is hotstarted from now on
+    g[0] = -5.;
+    EXPECT_TRUE(qp.updateTask(H,g));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_EQ(qp.getStats().hotstart_counter, 1u);
+    EXPECT_EQ(qp.getStats().warmstart_counter, 0u);
+    EXPECT_NEAR(qp.getSolution()[0], 5.,1E-6);
+}
+
+TEST_F(testQPOasesProblem, test_direct_kkt)
+{
+    OpenSoT::solvers::QPOasesProblem qp(3,2);
+    OpenSoT::solvers::QPOasesProblem qp_active_set(3,2);
+    qp.setDirectKKT(true);
+    EXPECT_TRUE(qp.isDirectKKT());
+    EXPECT_FALSE(qp_active_set.isDirectKKT());
+
+    Eigen::MatrixXd H(3,3);
+    H<<2,1,0,
+       1,3,1,
+       0,1,4;
+    Eigen::VectorXd g(3);
+    g<<-1,
+       -2,
+        1;
+    //an equality constraint and an inequality constraint
+    Eigen::MatrixXd A(2,3);
+    A<<1,1,1,
+       1,0,-1;
+    Eigen::VectorXd lA(2);
+    lA<<1,
+      -10;
+    Eigen::VectorXd uA(2);
+    uA<<1,
+       10;
+    Eigen::VectorXd l(3);
+    l<<-10,
+       -10,
+       -10;
+    Eigen::VectorXd u(3);
+    u<<10,
+       10,
+       10;
+    EXPECT_TRUE(qp.initProblem(H,g,A,lA,uA,l,u));
+    EXPECT_TRUE(qp_active_set.initProblem(H,g,A,lA,uA,l,u));
+
+    //only the equality constraint is active: qpOASES is not called
+    EXPECT_TRUE(qp.solve());
+    EXPECT_TRUE(qp_active_set.solve());
+    EXPECT_EQ(qp.getStats().direct_counter, 1u);
+    EXPECT_EQ(qp.getStats().hotstart_counter, 0u);
+    EXPECT_EQ(qp.getStats().active_constraints, 1);
+    EXPECT_EQ(qp.getStats().active_bounds, 0);
+    EXPECT_TRUE(qp.getSolution().isApprox(qp_active_set.getSolution(), 1E-9));
+    EXPECT_NEAR((A.row(0)*qp.getSolution())(0), 1., 1E-9);
+
+    //an active bound rejects the solution of the direct solve
+    u[2] = -1.;
+    EXPECT_TRUE(qp.updateBounds(l,u));
+    EXPECT_TRUE(qp_active_set.updateBounds(l,u));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_TRUE(qp_active_set.solve());
+    EXPECT_EQ(qp.getStats().direct_counter, 1u);
+    EXPECT_EQ(qp.getStats().hotstart_counter, 1u);
+    EXPECT_EQ(qp.getStats().active_bounds, 1);
+    EXPECT_NEAR(qp.getSolution()[2], -1., 1E-9);
+    EXPECT_TRUE(qp.getSolution().isApprox(qp_active_set.getSolution(), 1E-9));
+
+    //and so does an active inequality constraint
+    u[2] = 10.;
+    uA[1] = 0.;
+    EXPECT_TRUE(qp.updateBounds(l,u));
+    EXPECT_TRUE(qp.updateConstraints(A,lA,uA));
+    EXPECT_TRUE(qp_active_set.updateBounds(l,u));
+    EXPECT_TRUE(qp_active_set.updateConstraints(A,lA,uA));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_TRUE(qp_active_set.solve());
+    EXPECT_EQ(qp.getStats().direct_counter, 1u);
+    EXPECT_EQ(qp.getStats().active_constraints, 2);
+    EXPECT_TRUE(qp.getSolution().isApprox(qp_active_set.getSolution(), 1E-9));
+}
+
+TEST_F(testQPOasesProblem, test_vectors_hotstart)
+{
+    OpenSoT::solvers::QPOasesProblem qp(3,1);
+
+    Eigen::MatrixXd H(3,3);
+    H<<2,1,0,
+       1,3,1,
+       0,1,4;
+    Eigen::VectorXd g(3);
+    g<<-1,
+       -2,
+        1;
+    Eigen::MatrixXd A(1,3);
+    A<<1,1,1;
+    Eigen::VectorXd lA(1);
+    lA<<-1;
+    Eigen::VectorXd uA(1);
+    uA<<1;
+    Eigen::VectorXd l(3);
+    l<<-10,
+       -10,
+       -10;
+    Eigen::VectorXd u(3);
+    u<<10,
+       10,
+       10;
+    EXPECT_TRUE(qp.initProblem(H,g,A,lA,uA,l,u));
+
+    //H and A do not change: only the vectors are passed to qpOASES
+    for(unsigned int i = 0; i < 3; ++i)
+    {
+        g[0] -= 2.;
+        uA[0] = 0.5*i;
+        u[2] = -0.2*i;
+        EXPECT_TRUE(qp.updateTask(H,g));
+        EXPECT_TRUE(qp.updateConstraints(A,lA,uA));
+        EXPECT_TRUE(qp.updateBounds(l,u));
+        EXPECT_TRUE(qp.solve());
+
+        OpenSoT::solvers::QPOasesProblem qp_init(3,1);
+        EXPECT_TRUE(qp_init.initProblem(H,g,A,lA,uA,l,u));
+        EXPECT_TRUE(qp.getSolution().isApprox(qp_init.getSolution(), 1E-9));
+    }
+    EXPECT_EQ(qp.getStats().hotstart_counter, 3u);
+    EXPECT_EQ(qp.getStats().vectors_hotstart_counter, 3u);
+
+    //qpOASES regularises its own copy of H
+    EXPECT_TRUE(qp.getH() == H);
+
+    //a new A is passed to qpOASES
+    A<<1,2,1;
+    EXPECT_TRUE(qp.updateConstraints(A,lA,uA));
+    EXPECT_TRUE(qp.solve());
+    EXPECT_EQ(qp.getStats().hotstart_counter, 4u);
+    EXPECT_EQ(qp.getStats().vectors_hotstart_counter, 3u);
+    OpenSoT::solvers::QPOasesProblem qp_init(3,1);
+    EXPECT_TRUE(qp_init.initProblem(H,g,A,lA,uA,l,u));
+    EXPECT_TRUE(qp.getSolution().isApprox(qp_init.getSolution(), 1E-9));
+}
+
 TEST_F(testQPOasesProblem, test_update_task)
 {
     OpenSoT::solvers::QPOasesProblem qp(3,0);
@@ -993,6 +1440,303 @@ TEST_F(testQPOases_sot, testContructor1ProblemAggregated)
 
 }
 
+TEST_F(testQPOases_sot, testNullSpaceMode)
+{
+    std::list<unsigned int> indices1 = {0, 1};
+    std::list<unsigned int> indices2 = {1, 2, 3, 4};
+    createStack(indices1, indices2);
+
+    // a dense constraint couples the joints
+    Eigen::MatrixXd C(2, _n_dofs);
+    C.setRandom(2, _n_dofs);
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, -0.2*Eigen::VectorXd::Ones(2), 0.2*Eigen::VectorXd::Ones(2)));
+    _stack_of_tasks[1]->getConstraints().push_back(constraint);
+
+    std::list<OpenSoT::Constraint<Eigen::MatrixXd, Eigen::VectorXd>::ConstraintPtr> bounds_list;
+    bounds_list.push_back(_joint_vel_limits);
+    OpenSoT::constraints::Aggregated::Ptr bounds(
+                new OpenSoT::constraints::Aggregated(bounds_list, _n_dofs));
+    _constraints.push_back(bounds);
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, bounds);
+    OpenSoT::solvers::QPOases_sot sot_nullspace(_stack_of_tasks, bounds);
+    sot_nullspace.setNullSpaceMode(true);
+    EXPECT_TRUE(sot_nullspace.isNullSpaceMode());
+
+    for(unsigned int i = 0; i < 100; ++i)
+    {
+        // the second task is deactivated from time to time
+        sot.setActiveStack(1, i%10 < 7);
+        sot_nullspace.setActiveStack(1, i%10 < 7);
+
+        ASSERT_TRUE(solve({&sot, &sot_nullspace}));
+    }
+
+    // going back to the default mode
+    sot_nullspace.setNullSpaceMode(false);
+    ASSERT_TRUE(solve({&sot, &sot_nullspace}));
+}
+
+TEST_F(testQPOases_sot, testOptimalityCompression)
+{
+    // the second task is redundant with the first one on joints 1 and 2
+    std::list<unsigned int> indices1 = {0, 1, 2};
+    std::list<unsigned int> indices2 = {1, 2, 3};
+    createStack(indices1, indices2);
+
+    Eigen::MatrixXd C(2, _n_dofs);
+    C.setRandom(2, _n_dofs);
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, -0.2*Eigen::VectorXd::Ones(2), 0.2*Eigen::VectorXd::Ones(2)));
+    _stack_of_tasks[2]->getConstraints().push_back(constraint);
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, _joint_vel_limits);
+    OpenSoT::solvers::QPOases_sot sot_compressed(_stack_of_tasks, _joint_vel_limits);
+    sot_compressed.setOptimalityCompression(true);
+    EXPECT_TRUE(sot_compressed.isOptimalityCompression());
+
+    for(unsigned int i = 0; i < 50; ++i)
+    {
+        // the second task is deactivated from time to time
+        sot.setActiveStack(1, i%10 < 7);
+        sot_compressed.setActiveStack(1, i%10 < 7);
+
+        ASSERT_TRUE(solve({&sot, &sot_compressed}));
+
+        // the last task sees only the independent optimality constraints
+        if(i%10 < 7)
+        {
+            EXPECT_EQ(sot.getStats(2).problem.nC, 2 + 3 + 3);
+            EXPECT_EQ(sot_compressed.getStats(2).problem.nC, 2 + 4);
+        }
+        else
+            EXPECT_EQ(sot_compressed.getStats(2).problem.nC, 2 + 3);
+    }
+}
+
+TEST_F(testQPOases_sot, testSkippedLevels)
+{
+    // the first two tasks fix all the joints
+    std::list<unsigned int> indices1 = {0, 1, 2, 3};
+    std::list<unsigned int> indices2 = {2, 3, 4, 5, 6, 7};
+    createStack(indices1, indices2);
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, _joint_vel_limits);
+    OpenSoT::solvers::QPOases_sot sot_compressed(_stack_of_tasks, _joint_vel_limits);
+    sot_compressed.setOptimalityCompression(true);
+    OpenSoT::solvers::QPOases_sot sot_nullspace(_stack_of_tasks, _joint_vel_limits);
+    sot_nullspace.setNullSpaceMode(true);
+
+    for(unsigned int i = 0; i < 20; ++i)
+    {
+        ASSERT_TRUE(solve({&sot, &sot_compressed, &sot_nullspace}));
+
+        // the rank of the optimality constraints is not tracked by default
+        EXPECT_FALSE(sot.getStats(2).skipped);
+        for(unsigned int j = 0; j < 2; ++j)
+        {
+            EXPECT_FALSE(sot_compressed.getStats(j).skipped);
+            EXPECT_FALSE(sot_nullspace.getStats(j).skipped);
+        }
+        EXPECT_TRUE(sot_compressed.getStats(2).skipped);
+        EXPECT_TRUE(sot_nullspace.getStats(2).skipped);
+    }
+
+    // without the second task the last one is solved again
+    sot_compressed.setActiveStack(1, false);
+    sot_nullspace.setActiveStack(1, false);
+    ASSERT_TRUE(solve({&sot_compressed, &sot_nullspace}));
+    EXPECT_FALSE(sot_compressed.getStats(2).skipped);
+    EXPECT_FALSE(sot_nullspace.getStats(2).skipped);
+}
+
+TEST_F(testQPOases_sot, testConstraintScreening)
+{
+    std::list<unsigned int> indices = {0, 1, 2};
+    createStack(indices);
+
+    // only the first two rows can become active within the velocity limits
+    Eigen::MatrixXd C(10, _n_dofs);
+    C.setRandom(10, _n_dofs);
+    Eigen::VectorXd uC = Eigen::VectorXd::Constant(10, 5.);
+    uC.head(2).setConstant(0.02);
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, -uC, uC));
+    _constraints.push_back(constraint);
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, _joint_vel_limits, constraint);
+    OpenSoT::solvers::QPOases_sot sot_screening(_stack_of_tasks, _joint_vel_limits, constraint);
+    sot_screening.setConstraintScreening(true);
+    EXPECT_TRUE(sot_screening.isConstraintScreening());
+    EXPECT_TRUE(sot_screening.setConstraintsCapacity(0, 10));
+    EXPECT_TRUE(sot_screening.setConstraintsCapacity(1, 10 + 3));
+
+    // with a negative margin the active rows are screened too and the tasks are solved again
+    OpenSoT::solvers::QPOases_sot sot_resolve(_stack_of_tasks, _joint_vel_limits, constraint);
+    sot_resolve.setConstraintScreening(true, -1.);
+
+    for(unsigned int i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(solve({&sot, &sot_screening, &sot_resolve}));
+
+        for(unsigned int j = 0; j < _stack_of_tasks.size(); ++j)
+        {
+            EXPECT_EQ(sot.getStats(j).screened_constraints, 0);
+            EXPECT_EQ(sot_screening.getStats(j).screened_constraints, 8);
+            EXPECT_EQ(sot_screening.getStats(j).screening_resolve_counter, 0u);
+        }
+        // the solution with the screening satisfies all the rows
+        EXPECT_TRUE(((C*_dq[1]).array().abs() <= uC.array() + 1E-6).all());
+    }
+    EXPECT_GT(sot_resolve.getStats(0).screening_resolve_counter +
+              sot_resolve.getStats(1).screening_resolve_counter, 0u);
+}
+
+TEST_F(testQPOases_sot, testScreeningTolerance)
+{
+    std::list<unsigned int> indices = {0, 1, 2};
+    createStack(indices);
+
+    // the upper limits of the rows touch the range of C*dq within the velocity limits, which the
+    // solution reaches in the first ticks: the screened rows are violated only by the round-off
+    Eigen::MatrixXd C(50, _n_dofs);
+    C.setRandom(50, _n_dofs);
+    C = C.cwiseAbs();
+    C.col(3) *= -1.;
+    Eigen::VectorXd dq_max = Eigen::VectorXd::Constant(_n_dofs, 0.03);
+    dq_max[3] = -0.03;
+    Eigen::VectorXd uC = C*dq_max;
+    for(int r = 0; r < uC.size(); ++r)
+        uC[r] = std::nextafter(uC[r], 1.);
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, -uC - Eigen::VectorXd::Ones(50), uC));
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, _joint_vel_limits, constraint);
+    OpenSoT::solvers::QPOases_sot sot_screening(_stack_of_tasks, _joint_vel_limits, constraint);
+    sot_screening.setConstraintScreening(true);
+
+    for(unsigned int i = 0; i < 30; ++i)
+    {
+        ASSERT_TRUE(solve({&sot, &sot_screening}));
+
+        for(unsigned int j = 0; j < _stack_of_tasks.size(); ++j)
+            EXPECT_EQ(sot_screening.getStats(j).screening_resolve_counter, 0u);
+        EXPECT_TRUE(((C*_dq[1]).array() <= uC.array() + 1E-6).all());
+    }
+    EXPECT_GT(sot_screening.getStats(1).screened_constraints, 0);
+}
+
+TEST_F(testQPOases_sot, testBoundsPromotion)
+{
+    std::list<unsigned int> indices = {0, 1, 2};
+    createStack(indices);
+
+    // the first two rows involve a single joint
+    Eigen::MatrixXd C(4, _n_dofs);
+    C.setRandom(4, _n_dofs);
+    C.topRows(2).setZero();
+    C(0,0) = 2.;
+    C(1,3) = -1.;
+    Eigen::VectorXd lC(4), uC(4);
+    lC<<-0.01, -0.02, -0.02, -0.02;
+    uC<<0.01, 0.01, 0.02, 0.02;
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, lC, uC));
+    _constraints.push_back(constraint);
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, _joint_vel_limits, constraint);
+    OpenSoT::solvers::QPOases_sot sot_promotion(_stack_of_tasks, _joint_vel_limits, constraint);
+    sot_promotion.setBoundsPromotion(true);
+    EXPECT_TRUE(sot_promotion.isBoundsPromotion());
+
+    // when a task is solved again after the screening, the constraints are not promoted
+    OpenSoT::solvers::QPOases_sot sot_resolve(_stack_of_tasks, _joint_vel_limits, constraint);
+    sot_resolve.setBoundsPromotion(true);
+    sot_resolve.setConstraintScreening(true, -1.);
+
+    unsigned int resolve_counter[2] = {0, 0};
+    for(unsigned int i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(solve({&sot, &sot_promotion, &sot_resolve}));
+
+        EXPECT_EQ(sot.getStats(0).promoted_constraints, 0);
+        EXPECT_EQ(sot_promotion.getStats(0).promoted_constraints, 2);
+        EXPECT_EQ(sot_promotion.getStats(1).promoted_constraints, 2);
+        EXPECT_EQ(sot_promotion.getStats(0).problem.nC, 2);
+        EXPECT_EQ(sot_promotion.getStats(1).problem.nC, 2 + 3);
+
+        for(unsigned int j = 0; j < _stack_of_tasks.size(); ++j)
+        {
+            if(sot_resolve.getStats(j).screening_resolve_counter > resolve_counter[j])
+            {
+                EXPECT_EQ(sot_resolve.getStats(j).promoted_constraints, 0);
+                EXPECT_EQ(sot_resolve.getStats(j).screened_constraints, 0);
+            }
+            resolve_counter[j] = sot_resolve.getStats(j).screening_resolve_counter;
+        }
+
+        // the promoted rows act as bounds on the solution with the promotion
+        EXPECT_LE(std::fabs(_dq[1][0]), 0.005 + 1E-9);
+        EXPECT_LE(_dq[1][3], 0.02 + 1E-9);
+        EXPECT_GE(_dq[1][3], -0.01 - 1E-9);
+    }
+    EXPECT_GT(resolve_counter[0] + resolve_counter[1], 0u);
+}
+
+TEST_F(testQPOases_sot, testGlobalConstraints)
+{
+    std::list<unsigned int> indices = {0, 1, 2};
+    createStack(indices);
+
+    Eigen::MatrixXd C(3, _n_dofs);
+    C.setRandom(3, _n_dofs);
+    OpenSoT::constraints::BilateralConstraint::Ptr global_constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, -0.2*Eigen::VectorXd::Ones(3), 0.2*Eigen::VectorXd::Ones(3)));
+
+    // the global constraint is generated once for both the levels
+    OpenSoT::solvers::QPOases_sot sot_global(_stack_of_tasks, _joint_vel_limits, global_constraint);
+
+    // the same constraint, added to the constraints of each task
+    _stack_of_tasks[0]->getConstraints().push_back(global_constraint);
+    _stack_of_tasks[1]->getConstraints().push_back(global_constraint);
+    OpenSoT::solvers::QPOases_sot sot_tasks(_stack_of_tasks, _joint_vel_limits);
+
+    for(unsigned int i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(solve({&sot_global, &sot_tasks}, 1E-9));
+
+        EXPECT_EQ(sot_global.getStats(0).problem.nC, 3);
+        EXPECT_EQ(sot_global.getStats(1).problem.nC, 3 + 3);
+        EXPECT_TRUE(((C*_dq[0]).array().abs() <= 0.2 + 1E-6).all());
+    }
+}
+
+TEST_F(testQPOases_sot, testClosedFormMask)
+{
+    OpenSoT::tasks::velocity::Postural::Ptr postural_task(
+            new OpenSoT::tasks::velocity::Postural(_q));
+    postural_task->setReference(Eigen::VectorXd::LinSpaced(_n_dofs, -2., 2.));
+    _stack_of_tasks.push_back(postural_task);
+
+    OpenSoT::solvers::QPOases_sot sot(_stack_of_tasks, _joint_vel_limits);
+    for(unsigned int i = 0; i < 3; ++i)
+        ASSERT_TRUE(solve({&sot}));
+    unsigned int closed_form_counter = sot.getStats(0).problem.closed_form_counter;
+    EXPECT_GT(closed_form_counter, 0u);
+
+    // with a mask A'A is not the identity: the level goes back to qpOASES
+    std::vector<bool> mask(_n_dofs, true);
+    mask[0] = false;
+    ASSERT_TRUE(postural_task->setActiveJointsMask(mask));
+    for(unsigned int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(solve({&sot}));
+        EXPECT_EQ(sot.getStats(0).problem.closed_form_counter, closed_form_counter);
+        EXPECT_NEAR(_dq[0][0], 0., 1E-6);
+    }
+}
+
 TEST_F(testQPOases_sot, testMinEffort)
 {
     XBot::ModelInterface::Ptr _model_ptr;
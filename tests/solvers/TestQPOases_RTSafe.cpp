@@ -0,0 +1,343 @@
+#include <gtest/gtest.h>
+#include <OpenSoT/constraints/Aggregated.h>
+#include <OpenSoT/constraints/BilateralConstraint.h>
+#include <OpenSoT/constraints/velocity/VelocityLimits.h>
+#include <OpenSoT/tasks/Aggregated.h>
+#include <OpenSoT/tasks/velocity/Postural.h>
+#include <OpenSoT/solvers/QPOases.h>
+#include <OpenSoT/SubTask.h>
+#include <qpOASES.hpp>
+#include <cstdlib>
+#include <cmath>
+
+/**
+ * The allocations are counted by replacing malloc, calloc and realloc
+ * (operator new and Eigen end up here) with functions forwarding to glibc.
+ */
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t n, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+}
+
+namespace {
+    bool count_allocations = false;
+    unsigned int allocations = 0;
+}
+
+extern "C" {
+    void* malloc(size_t size)
+    {
+        if(count_allocations)
+            ++allocations;
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t n, size_t size)
+    {
+        if(count_allocations)
+            ++allocations;
+        return __libc_calloc(n, size);
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        if(count_allocations)
+            ++allocations;
+        return __libc_realloc(ptr, size);
+    }
+}
+
+namespace {
+
+void startCountingAllocations()
+{
+    allocations = 0;
+    count_allocations = true;
+}
+
+unsigned int stopCountingAllocations()
+{
+    count_allocations = false;
+    return allocations;
+}
+
+/**
+ * @brief The DenseTask class is a task with a dense A which changes at every update
+ */
+class DenseTask: public OpenSoT::Task<Eigen::MatrixXd, Eigen::VectorXd>
+{
+public:
+    typedef boost::shared_ptr<DenseTask> Ptr;
+
+    DenseTask(const Eigen::MatrixXd& M):
+        Task("DenseTask", M.cols()), _M(M), _updates(0)
+    {
+        _W.setIdentity(M.rows(), M.rows());
+        _b.setConstant(M.rows(), 0.1);
+        _update(Eigen::VectorXd::Zero(M.cols()));
+    }
+
+protected:
+    void _update(const Eigen::VectorXd& x)
+    {
+        ++_updates;
+        _A = _M;
+        _A.row(0) *= 1. + 0.5*std::sin(0.1*_updates);
+    }
+
+private:
+    Eigen::MatrixXd _M;
+    unsigned int _updates;
+};
+
+class testQPOases_RTSafe: public ::testing::Test
+{
+protected:
+
+    testQPOases_RTSafe():
+        n_dofs(8),
+        q(Eigen::VectorXd::Zero(n_dofs))
+    {
+        postural_task1.reset(new OpenSoT::tasks::velocity::Postural(q));
+        postural_task1->setReference(Eigen::VectorXd::Constant(n_dofs, 1.));
+        postural_task2.reset(new OpenSoT::tasks::velocity::Postural(q));
+        postural_task2->setReference(Eigen::VectorXd::LinSpaced(n_dofs, -2., 2.));
+
+        std::list<unsigned int> indices = {0, 1, 2};
+        sub_task1.reset(new OpenSoT::SubTask(postural_task1, indices));
+
+        C.setRandom(2, n_dofs);
+        constraint.reset(new OpenSoT::constraints::BilateralConstraint(
+                             C, -0.2*Eigen::VectorXd::Ones(2), 0.2*Eigen::VectorXd::Ones(2)));
+        postural_task2->getConstraints().push_back(constraint);
+
+        joint_vel_limits.reset(new OpenSoT::constraints::velocity::VelocityLimits(0.3, 0.1, n_dofs));
+
+        stack_of_tasks.push_back(sub_task1);
+        stack_of_tasks.push_back(postural_task2);
+    }
+
+    virtual ~testQPOases_RTSafe() {
+
+    }
+
+    virtual void SetUp() {
+
+    }
+
+    virtual void TearDown() {
+
+    }
+
+    /**
+     * @brief update updates the tasks of the stack and the bounds
+     */
+    void update()
+    {
+        for(unsigned int j = 0; j < stack_of_tasks.size(); ++j)
+            stack_of_tasks[j]->update(q);
+        joint_vel_limits->update(q);
+    }
+
+    /**
+     * @brief stack of two Postural tasks, the first on three joints only and the second with
+     * two constraints, plus joint velocity limits
+     */
+    int n_dofs;
+    Eigen::VectorXd q;
+    OpenSoT::tasks::velocity::Postural::Ptr postural_task1;
+    OpenSoT::tasks::velocity::Postural::Ptr postural_task2;
+    OpenSoT::SubTask::Ptr sub_task1;
+    Eigen::MatrixXd C;
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint;
+    OpenSoT::constraints::velocity::VelocityLimits::Ptr joint_vel_limits;
+    OpenSoT::solvers::QPOases_sot::Stack stack_of_tasks;
+};
+
+TEST_F(testQPOases_RTSafe, testAggregatedGenerateAll)
+{
+    int n_dofs = 6;
+    Eigen::VectorXd q(n_dofs); q.setZero(n_dofs);
+
+    Eigen::MatrixXd C(3, n_dofs);
+    C.setRandom(3, n_dofs);
+    OpenSoT::constraints::BilateralConstraint::Ptr constraint(
+        new OpenSoT::constraints::BilateralConstraint(C, -Eigen::VectorXd::Ones(3), Eigen::VectorXd::Ones(3)));
+    OpenSoT::constraints::velocity::VelocityLimits::Ptr joint_vel_limits(
+        new OpenSoT::constraints::velocity::VelocityLimits(0.3, 0.1, n_dofs));
+    Eigen::VectorXd limits = Eigen::VectorXd::LinSpaced(n_dofs, 0.2, 0.4);
+    OpenSoT::constraints::velocity::VelocityLimits::Ptr joint_vel_limits2(
+        new OpenSoT::constraints::velocity::VelocityLimits(limits, 0.1));
+
+    std::list<OpenSoT::Constraint<Eigen::MatrixXd, Eigen::VectorXd>::ConstraintPtr> constraints_list;
+    constraints_list.push_back(constraint);
+    constraints_list.push_back(joint_vel_limits);
+    constraints_list.push_back(joint_vel_limits2);
+
+    OpenSoT::constraints::Aggregated bilateral(constraints_list, n_dofs);
+    OpenSoT::constraints::Aggregated unilateral(constraints_list, n_dofs,
+                                OpenSoT::constraints::Aggregated::EQUALITIES_TO_INEQUALITIES);
+
+    // warm-up
+    bilateral.generateAll();
+    unilateral.generateAll();
+
+    startCountingAllocations();
+    for(unsigned int i = 0; i < 10; ++i)
+    {
+        bilateral.generateAll();
+        unilateral.generateAll();
+    }
+    EXPECT_EQ(stopCountingAllocations(), 0);
+
+    EXPECT_EQ(bilateral.getAineqRowMajor().rows(), 3);
+    EXPECT_EQ(unilateral.getAineqRowMajor().rows(), 6);
+    EXPECT_TRUE(unilateral.getAineqRowMajor().bottomRows(3).isApprox(-C));
+
+    // the bounds are the intersection of the ones of the two limits
+    EXPECT_TRUE(bilateral.getUpperBound() ==
+                joint_vel_limits->getUpperBound().cwiseMin(joint_vel_limits2->getUpperBound()));
+    EXPECT_TRUE(bilateral.getLowerBound() ==
+                joint_vel_limits->getLowerBound().cwiseMax(joint_vel_limits2->getLowerBound()));
+}
+
+TEST_F(testQPOases_RTSafe, testAggregatedTaskUpdate)
+{
+    int n_dofs = 6;
+    Eigen::VectorXd q(n_dofs); q.setZero(n_dofs);
+
+    OpenSoT::tasks::velocity::Postural::Ptr postural_task1(
+            new OpenSoT::tasks::velocity::Postural(q));
+    OpenSoT::tasks::velocity::Postural::Ptr postural_task2(
+            new OpenSoT::tasks::velocity::Postural(q));
+    postural_task2->setWeight(Eigen::VectorXd::LinSpaced(n_dofs, 1., 2.).asDiagonal());
+
+    std::list<OpenSoT::tasks::Aggregated::TaskPtr> task_list;
+    task_list.push_back(postural_task1);
+    task_list.push_back(postural_task2);
+    OpenSoT::tasks::Aggregated aggregated(task_list, n_dofs);
+
+    // warm-up
+    aggregated.update(q);
+
+    startCountingAllocations();
+    for(unsigned int i = 0; i < 10; ++i)
+    {
+        q.setConstant(0.1*i);
+        aggregated.update(q);
+    }
+    EXPECT_EQ(stopCountingAllocations(), 0);
+
+    EXPECT_EQ(aggregated.getA().rows(), 2*n_dofs);
+    EXPECT_TRUE(aggregated.getb().tail(n_dofs).isApprox(
+                    postural_task2->getWeight()*postural_task2->getb()));
+}
+
+TEST_F(testQPOases_RTSafe, testSolve)
+{
+    // a last level with a dense task whose A changes at every tick: its Hessian is computed
+    // again and the problem is hotstarted with it
+    Eigen::MatrixXd M(3, n_dofs);
+    M.setRandom(3, n_dofs);
+    DenseTask::Ptr dense_task(new DenseTask(M));
+    stack_of_tasks.push_back(dense_task);
+
+    std::list<OpenSoT::Constraint<Eigen::MatrixXd, Eigen::VectorXd>::ConstraintPtr> bounds_list;
+    bounds_list.push_back(joint_vel_limits);
+    OpenSoT::constraints::Aggregated::Ptr bounds(
+                new OpenSoT::constraints::Aggregated(bounds_list, n_dofs));
+
+    OpenSoT::solvers::QPOases_sot sot(stack_of_tasks, bounds);
+
+    Eigen::VectorXd dq(n_dofs);
+    unsigned int A_generation = dense_task->getAGeneration();
+    for(unsigned int i = 0; i < 100; ++i)
+    {
+        update();
+        bounds->update(q);
+        EXPECT_GT(dense_task->getAGeneration(), A_generation);
+        A_generation = dense_task->getAGeneration();
+
+        // the first ticks are the warm-up
+        if(i >= 10)
+            startCountingAllocations();
+        bool solved = sot.solve(dq);
+        unsigned int solve_allocations = stopCountingAllocations();
+
+        ASSERT_TRUE(solved);
+        if(i >= 10)
+            EXPECT_EQ(solve_allocations, 0)<<"solve() allocated at tick "<<i;
+
+        q += dq;
+    }
+    EXPECT_EQ(sot.getStats(2).problem.hotstart_counter, 100u);
+    EXPECT_EQ(sot.getStats(2).problem.vectors_hotstart_counter, 0u);
+}
+
+TEST_F(testQPOases_RTSafe, testSolveNullSpace)
+{
+    Eigen::MatrixXd M(3, n_dofs);
+    M.setRandom(3, n_dofs);
+    DenseTask::Ptr dense_task(new DenseTask(M));
+    stack_of_tasks.insert(stack_of_tasks.begin() + 1, dense_task);
+
+    OpenSoT::solvers::QPOases_sot sot(stack_of_tasks, joint_vel_limits);
+    sot.setNullSpaceMode(true);
+
+    Eigen::VectorXd dq(n_dofs);
+    for(unsigned int i = 0; i < 100; ++i)
+    {
+        update();
+
+        // the first ticks are the warm-up, in which the problems are resized
+        if(i >= 10)
+            startCountingAllocations();
+        bool solved = sot.solve(dq);
+        unsigned int solve_allocations = stopCountingAllocations();
+
+        ASSERT_TRUE(solved);
+        if(i >= 10)
+            EXPECT_EQ(solve_allocations, 0)<<"solve() allocated at tick "<<i;
+
+        q += dq;
+    }
+    // the variables of the last level are the ones left free by the first two
+    EXPECT_FALSE(sot.getStats(2).skipped);
+    EXPECT_EQ(sot.getStats(2).problem.nV, n_dofs - 3 - 3);
+}
+
+TEST_F(testQPOases_RTSafe, testArena)
+{
+    OpenSoT::solvers::QPOases_sot::Ptr sot(
+                new OpenSoT::solvers::QPOases_sot(stack_of_tasks, joint_vel_limits));
+
+    // all the levels, with their factorizations, fit exactly in the arena
+    boost::shared_ptr<qpOASES::Arena> arena = sot->getArena();
+    ASSERT_TRUE(bool(arena));
+    EXPECT_GT(arena->getSize(), 0);
+    EXPECT_EQ(arena->getUsed(), arena->getSize());
+    EXPECT_EQ(arena->getSize(),
+              OpenSoT::solvers::QPOasesProblem::getArenaSize(n_dofs, 0) +
+              OpenSoT::solvers::QPOasesProblem::getArenaSize(n_dofs, 2 + 3));
+
+    Eigen::VectorXd dq(n_dofs);
+    for(unsigned int i = 0; i < 10; ++i)
+    {
+        update();
+        ASSERT_TRUE(sot->solve(dq));
+        q += dq;
+    }
+    EXPECT_TRUE(((C*q).array().abs() <= 0.2*10 + 1e-6).all());
+
+    // the arena outlives the solver as long as somebody refers to it
+    sot.reset();
+    EXPECT_EQ(arena->getUsed(), arena->getSize());
+}
+
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <OpenSoT/tasks/Aggregated.h>
+#include <OpenSoT/SubTask.h>
 #include <OpenSoT/tasks/velocity/Postural.h>
 #include <OpenSoT/tasks/velocity/Cartesian.h>
 #include <OpenSoT/constraints/velocity/CoMVelocity.h>
@@ -269,6 +270,108 @@ bool vectorAreEqual(const Eigen::VectorXd& v0,
     return areEqual;
 }
 
+TEST_F(testAggregatedTask, testWeightedTasks)
+{
+    std::list< Aggregated::TaskPtr > tasks;
+    for(unsigned int i = 0; i < 3; ++i)
+        tasks.push_back(Aggregated::TaskPtr(new velocity::Postural((i+1.)*q)));
+
+    std::list< Aggregated::TaskPtr >::iterator task = tasks.begin();
+    // identity, diagonal and full weight
+    ++task;
+    Eigen::MatrixXd W_diagonal = Eigen::VectorXd::LinSpaced(q.size(), 1., 2.).asDiagonal();
+    (*task)->setWeight(W_diagonal);
+    ++task;
+    Eigen::MatrixXd W_full(q.size(), q.size());
+    W_full.setRandom();
+    W_full = W_full*W_full.transpose() + Eigen::MatrixXd::Identity(q.size(), q.size());
+    (*task)->setWeight(W_full);
+
+    Aggregated aggregated(tasks, q);
+
+    for(unsigned int k = 0; k < 3; ++k)
+    {
+        Eigen::MatrixXd PileA(3*q.size(), q.size());
+        Eigen::VectorXd Pileb(3*q.size());
+        unsigned int rows = 0;
+        for(task = tasks.begin(); task != tasks.end(); ++task)
+        {
+            PileA.middleRows(rows, q.size()) = (*task)->getWeight()*(*task)->getA();
+            Pileb.segment(rows, q.size()) = (*task)->getWeight()*(*task)->getb();
+            rows += q.size();
+        }
+
+        EXPECT_TRUE(matrixAreEqual(aggregated.getA(), PileA));
+        EXPECT_TRUE(vectorAreEqual(aggregated.getb(), Pileb));
+
+        q.setRandom();
+        aggregated.update(q);
+    }
+}
+
+TEST_F(testAggregatedTask, testJacobianType)
+{
+    Aggregated::TaskPtr postural(new velocity::Postural(q));
+    std::list<unsigned int> indices = {1, 3};
+    Aggregated::TaskPtr sub_task(new OpenSoT::SubTask(postural, indices));
+
+    std::list< Aggregated::TaskPtr > tasks;
+    tasks.push_back(postural);
+    tasks.push_back(sub_task);
+    Aggregated aggregated(tasks, q);
+
+    ASSERT_EQ(aggregated.getJacobianType(), OpenSoT::JT_SELECTION);
+    ASSERT_EQ(aggregated.getJacobianSelection().size(), q.size() + 2);
+    for(unsigned int r = 0; r < aggregated.getJacobianSelection().size(); ++r)
+        EXPECT_TRUE(aggregated.getA().row(r) ==
+                    Eigen::MatrixXd::Identity(q.size(), q.size()).row(aggregated.getJacobianSelection()[r]));
+    EXPECT_EQ(aggregated.getJacobianSelection()[q.size()], 1);
+    EXPECT_EQ(aggregated.getJacobianSelection()[q.size()+1], 3);
+
+    std::list< Aggregated::TaskPtr > single_task(1, postural);
+    EXPECT_EQ(Aggregated(single_task, q).getJacobianType(), OpenSoT::JT_IDENTITY);
+
+    // a mask hides the structure until A is piled again without it
+    std::vector<bool> active_joints_mask(q.size(), true);
+    active_joints_mask[1] = false;
+    aggregated.setActiveJointsMask(active_joints_mask);
+    aggregated.update(q);
+    EXPECT_EQ(aggregated.getJacobianType(), OpenSoT::JT_DENSE);
+    aggregated.setActiveJointsMask(std::vector<bool>(q.size(), true));
+    aggregated.update(q);
+    EXPECT_EQ(aggregated.getJacobianType(), OpenSoT::JT_SELECTION);
+
+    // rows scaled by a weight are not a selection anymore
+    sub_task->setWeight(2.*Eigen::MatrixXd::Identity(2, 2));
+    aggregated.update(q);
+    EXPECT_EQ(aggregated.getJacobianType(), OpenSoT::JT_DENSE);
+}
+
+TEST_F(testAggregatedTask, testGenerations)
+{
+    Aggregated::TaskPtr postural(new velocity::Postural(q));
+    std::list<unsigned int> indices = {1, 3};
+    Aggregated::TaskPtr sub_task(new OpenSoT::SubTask(postural, indices));
+
+    std::list< Aggregated::TaskPtr > tasks;
+    tasks.push_back(postural);
+    tasks.push_back(sub_task);
+    Aggregated aggregated(tasks, q);
+    aggregated.update(q);
+
+    // A is piled again only when it changes in some task
+    const unsigned int A_generation = aggregated.getAGeneration();
+    const unsigned int b_generation = aggregated.getbGeneration();
+    aggregated.update(q);
+    EXPECT_EQ(aggregated.getAGeneration(), A_generation);
+    EXPECT_NE(aggregated.getbGeneration(), b_generation);
+
+    sub_task->setWeight(2.*Eigen::MatrixXd::Identity(2, 2));
+    aggregated.update(q);
+    EXPECT_NE(aggregated.getAGeneration(), A_generation);
+    EXPECT_TRUE(aggregated.getA().bottomRows(2) == 2.*sub_task->getA());
+}
+
 TEST_F(testAggregatedTask, testConstraintsUpdate)
 {
     _model_ptr = XBot::ModelInterface::getModel(_path_to_cfg);
@@ -491,6 +491,131 @@ TEST_F(TestSubTask, testGetConstraints)
     EXPECT_FALSE( lowerBounds == subTask->getConstraints().front()->getLowerBound());
 }
 
+TEST_F(TestSubTask, testWeightType)
+{
+    using namespace OpenSoT;
+
+    Eigen::VectorXd q(DOFS); q.setZero(DOFS);
+    SubTask::Ptr subTask(new SubTask(_postural, Indices::range(0,2) +
+                                                Indices::range(5,6)));
+    unsigned int c_indices[] = {0, 1, 2, 5, 6};
+    std::vector<unsigned int> indices(c_indices,c_indices+sizeof(c_indices)/sizeof(indices[0]));
+
+    Eigen::MatrixXd W_diagonal(DOFS,DOFS);
+    W_diagonal.setZero(DOFS,DOFS);
+    for(unsigned int i = 0; i < DOFS; ++i)
+        W_diagonal(i,i) = i+1;
+    Eigen::MatrixXd W_dense(DOFS,DOFS);
+    W_dense.setRandom(DOFS,DOFS);
+    W_dense = W_dense*W_dense.transpose() + Eigen::MatrixXd::Identity(DOFS,DOFS);
+
+    // the structure of the weight follows the one of the father task, back to the identity
+    std::vector<Eigen::MatrixXd> weights;
+    weights.push_back(Eigen::MatrixXd::Identity(DOFS,DOFS));
+    weights.push_back(W_diagonal);
+    weights.push_back(W_dense);
+    weights.push_back(Eigen::MatrixXd::Identity(DOFS,DOFS));
+    WeightType types[] = {WT_IDENTITY, WT_DIAGONAL, WT_DENSE, WT_IDENTITY};
+
+    for(unsigned int k = 0; k < weights.size(); ++k)
+    {
+        _postural->setWeight(weights[k]);
+        subTask->update(q);
+
+        EXPECT_EQ(_postural->getWeightType(), types[k]);
+        EXPECT_EQ(subTask->getWeightType(), types[k]);
+
+        Eigen::MatrixXd W(indices.size(), indices.size());
+        for(unsigned int r = 0; r < indices.size(); ++r)
+            for(unsigned int c = 0; c < indices.size(); ++c)
+                W(r,c) = weights[k](indices[r], indices[c]);
+        EXPECT_TRUE(matrixAreEqual(subTask->getWeight(),W));
+        EXPECT_TRUE(matrixAreEqual(subTask->getWA(),W*subTask->getA()));
+        EXPECT_TRUE(vectorAreEqual(subTask->getWb(),W*subTask->getb()));
+    }
+}
+
+TEST_F(TestSubTask, testJacobianType)
+{
+    using namespace OpenSoT;
+
+    Eigen::VectorXd q(DOFS); q.setZero(DOFS);
+    EXPECT_EQ(_postural->getJacobianType(), JT_IDENTITY);
+
+    SubTask::Ptr subTask(new SubTask(_postural, Indices::range(0,2) +
+                                                Indices::range(5,6)));
+    ASSERT_EQ(subTask->getJacobianType(), JT_SELECTION);
+    SubTask::Ptr subSubTask(new SubTask(subTask, Indices::range(2,3)));
+    ASSERT_EQ(subSubTask->getJacobianType(), JT_SELECTION);
+
+    unsigned int c_indices[] = {0, 1, 2, 5, 6};
+    std::vector<unsigned int> indices(c_indices,c_indices+sizeof(c_indices)/sizeof(indices[0]));
+    EXPECT_TRUE(subTask->getJacobianSelection() == indices);
+    EXPECT_EQ(subSubTask->getJacobianSelection().size(), 2);
+    EXPECT_EQ(subSubTask->getJacobianSelection()[0], 2);
+    EXPECT_EQ(subSubTask->getJacobianSelection()[1], 5);
+    for(unsigned int r = 0; r < indices.size(); ++r)
+        EXPECT_TRUE(subTask->getA().row(r) == Eigen::MatrixXd::Identity(DOFS,DOFS).row(indices[r]));
+
+    // a masked jacobian loses its structure
+    std::vector<bool> active_joints_mask(DOFS, true);
+    active_joints_mask[1] = false;
+    _postural->setActiveJointsMask(active_joints_mask);
+    subTask->update(q);
+    EXPECT_EQ(_postural->getJacobianType(), JT_DENSE);
+    EXPECT_EQ(subTask->getJacobianType(), JT_DENSE);
+}
+
+TEST_F(TestSubTask, testGenerations)
+{
+    using namespace OpenSoT;
+
+    Eigen::VectorXd q(DOFS); q.setZero(DOFS);
+    SubTask::Ptr subTask(new SubTask(_postural, Indices::range(1,3)));
+    subTask->update(q);
+
+    // the A of the postural is constant: only b changes on update
+    unsigned int postural_A_generation = _postural->getAGeneration();
+    unsigned int A_generation = subTask->getAGeneration();
+    unsigned int b_generation = subTask->getbGeneration();
+    unsigned int W_generation = subTask->getWeightGeneration();
+    q.setConstant(0.1);
+    subTask->update(q);
+    EXPECT_EQ(_postural->getAGeneration(), postural_A_generation);
+    EXPECT_EQ(subTask->getAGeneration(), A_generation);
+    EXPECT_EQ(subTask->getWeightGeneration(), W_generation);
+    EXPECT_NE(subTask->getbGeneration(), b_generation);
+
+    // a new weight of the father task is seen by the subtask
+    Eigen::MatrixXd W(DOFS,DOFS);
+    W.setIdentity(DOFS,DOFS);
+    W(2,2) = 3.;
+    _postural->setWeight(W);
+    subTask->update(q);
+    EXPECT_NE(subTask->getWeightGeneration(), W_generation);
+    EXPECT_EQ(subTask->getAGeneration(), A_generation);
+    EXPECT_DOUBLE_EQ(subTask->getWeight()(1,1), 3.);
+
+    // as well as a mask on the father task
+    std::vector<bool> active_joints_mask(DOFS, true);
+    active_joints_mask[2] = false;
+    _postural->setActiveJointsMask(active_joints_mask);
+    subTask->update(q);
+    EXPECT_NE(subTask->getAGeneration(), A_generation);
+    EXPECT_TRUE(subTask->getA().col(2).isZero());
+
+    // an inactive subtask is zeroed, once active again A is generated only when it changes
+    subTask->setActive(false);
+    subTask->update(q);
+    EXPECT_TRUE(subTask->getA().isZero());
+    subTask->setActive(true);
+    EXPECT_DOUBLE_EQ(subTask->getA()(0,1), 1.);
+    A_generation = subTask->getAGeneration();
+    subTask->update(q);
+    subTask->update(q);
+    EXPECT_EQ(subTask->getAGeneration(), A_generation);
+}
+
 TEST_F(TestSubTask, testUpdate)
 {
     using namespace OpenSoT;
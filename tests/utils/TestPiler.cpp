@@ -73,6 +73,66 @@ TEST_F(testPiler, checkPiler)
 
 }
 
+TEST_F(testPiler, checkRowMajorPiler)
+{
+    int ncols = 30;
+    OpenSoT::utils::RowMajorMatrixPiler piler(ncols);
+
+    Eigen::MatrixXd A;
+    Eigen::MatrixXd Apiled(0, ncols);
+
+    for(int i = 0; i < 5; i++)
+    {
+        A.setRandom(3*i + 1, ncols);
+
+        piler.pile(A);
+        pile(Apiled, A);
+
+        EXPECT_TRUE( ( (Apiled - piler.get()).array() == 0).all() );
+    }
+
+    // rows are contiguous in memory, as qpOASES expects them
+    Eigen::Block<const OpenSoT::utils::RowMajorMatrixXd> piled = piler.get();
+    for(int r = 0; r < piled.rows(); r++)
+        for(int c = 0; c < ncols; c++)
+            EXPECT_EQ(piled.data()[r*ncols + c], Apiled(r,c));
+}
+
+TEST_F(testPiler, checkReserve)
+{
+    int ncols = 10;
+    OpenSoT::utils::MatrixPiler piler(ncols);
+    piler.reserve(20);
+    EXPECT_EQ(piler.capacity(), 20);
+    EXPECT_EQ(piler.rows(), 0);
+
+    const double* data = piler.get().data();
+
+    Eigen::MatrixXd A;
+    Eigen::MatrixXd Apiled(0, ncols);
+    for(int k = 0; k < 3; k++)
+    {
+        piler.reset();
+        Apiled.resize(0, ncols);
+        for(int i = 0; i < 4; i++)
+        {
+            A.setRandom(i + k + 1, ncols);
+
+            piler.pile(A);
+            pile(Apiled, A);
+        }
+
+        // at most 18 rows are piled: no expansion is needed
+        EXPECT_TRUE( ( (Apiled - piler.get()).array() == 0).all() );
+        EXPECT_EQ(piler.capacity(), 20);
+        EXPECT_EQ(piler.get().data(), data);
+    }
+
+    // reserving less than the capacity does nothing
+    piler.reserve(5);
+    EXPECT_EQ(piler.capacity(), 20);
+}
+
 }
 
 int main(int argc, char **argv) {